@@ -0,0 +1,94 @@
+#include "texture_atlas.h"
+
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+bool TextureAtlas::load(const std::string& manifestPath)
+{
+    std::ifstream in(manifestPath);
+    if (!in.is_open())
+    {
+        std::cerr << "[TextureAtlas] Failed to open manifest: " << manifestPath << '\n';
+        return false;
+    }
+
+    m_rects.clear();
+    m_imagePath.clear();
+    m_texture = nullptr;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string        kind, name;
+        fields >> kind >> name;
+        if (kind == "image")
+        {
+            m_imagePath = (std::filesystem::path(manifestPath).parent_path() / name).string();
+        }
+        else if (kind == "sprite")
+        {
+            int x = 0, y = 0, w = 0, h = 0;
+            if (fields >> x >> y >> w >> h)
+                m_rects[name] = sf::IntRect({x, y}, {w, h});
+        }
+    }
+
+    if (m_imagePath.empty())
+    {
+        std::cerr << "[TextureAtlas] Manifest names no image: " << manifestPath << '\n';
+        return false;
+    }
+
+    // Loaded by file name so that tguiTexture() hits TGUI's texture cache
+    try
+    {
+        m_whole.load(m_imagePath);
+    }
+    catch (const tgui::Exception& e)
+    {
+        std::cerr << "[TextureAtlas] Failed to load " << m_imagePath << ": " << e.what() << '\n';
+        return false;
+    }
+
+    auto backend =
+        std::dynamic_pointer_cast<tgui::BackendTextureSFML>(m_whole.getData()->backendTexture);
+    if (!backend)
+    {
+        std::cerr << "[TextureAtlas] Requires the SFML graphics backend.\n";
+        return false;
+    }
+    m_texture = &backend->getInternalTexture();
+    return true;
+}
+
+sf::IntRect TextureAtlas::rect(std::string_view name) const
+{
+    const auto it = m_rects.find(std::string(name));
+    return it != m_rects.end() ? it->second : sf::IntRect{};
+}
+
+tgui::Texture TextureAtlas::tguiTexture(std::string_view name) const
+{
+    const sf::IntRect r = rect(name);
+    if (!isLoaded() || r.size.x <= 0 || r.size.y <= 0)
+        return {};
+
+    // Same file name as m_whole, so TGUI's texture manager hands out the backend texture it
+    // cached for m_whole (kept alive by m_whole itself) instead of loading the image again.
+    // In-place updates of texture() are only visible to widgets because of this sharing.
+    tgui::Texture texture(
+        m_imagePath,
+        {static_cast<unsigned>(r.position.x),
+         static_cast<unsigned>(r.position.y),
+         static_cast<unsigned>(r.size.x),
+         static_cast<unsigned>(r.size.y)});
+    assert(
+        texture.getData()->backendTexture == m_whole.getData()->backendTexture
+        && "TGUI no longer shares cached textures: atlas sprites would not see texture() updates");
+    return texture;
+}
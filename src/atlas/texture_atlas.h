@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <TGUI/Backend/SFML-Graphics.hpp>
+#include <TGUI/Texture.hpp>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief The UI texture atlas packed at build time by `atlas_packer` (target `ui_atlas`).
+ *
+ * All UI sprites live in one GPU texture. SFML drawing uses `texture()` with a sprite's
+ * `rect()`. TGUI widgets get `tguiTexture()`, which shares the same GPU texture through TGUI's
+ * texture cache. Reserved slots (e.g. the welcome mask) are updated in place with
+ * `texture().update(...)` at their rect's position.
+ *
+ * Widgets see those updates only because TGUI's texture manager caches textures by file name:
+ * every `tguiTexture()` is loaded from the atlas image path and gets the backend texture
+ * already loaded for the whole atlas. Debug builds assert that this is still the case.
+ */
+class TextureAtlas
+{
+  public:
+    // Read the manifest (<name>.atlas) and upload its image. Main thread only.
+    bool load(const std::string& manifestPath);
+
+    [[nodiscard]] bool isLoaded() const
+    {
+        return m_texture != nullptr;
+    }
+
+    // Sprite rectangle in atlas pixels; empty if the name is unknown
+    [[nodiscard]] sf::IntRect rect(std::string_view name) const;
+
+    // The GPU texture every atlas sprite shares. Only valid once isLoaded().
+    [[nodiscard]] const sf::Texture& texture() const
+    {
+        return *m_texture;
+    }
+
+    // Writable access, for updating reserved slots in place
+    [[nodiscard]] sf::Texture& texture()
+    {
+        return *m_texture;
+    }
+
+    // Sprite as a TGUI texture (same GPU texture, sub-rectangle)
+    [[nodiscard]] tgui::Texture tguiTexture(std::string_view name) const;
+
+  private:
+    std::string                                  m_imagePath;
+    std::unordered_map<std::string, sf::IntRect> m_rects;
+    tgui::Texture                                m_whole; // keeps TGUI's cached texture alive
+    sf::Texture*                                 m_texture = nullptr;
+};
@@ -0,0 +1,99 @@
+#include "array_writer.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+namespace ArrayWriter
+{
+namespace
+{
+struct FileCloser
+{
+    void operator()(std::FILE* file) const noexcept
+    {
+        std::fclose(file);
+    }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+FilePtr openForWriting(const std::string& filename)
+{
+    FilePtr file(std::fopen(filename.c_str(), "wb"));
+    if (!file)
+        std::cerr << "Failed to open file: " << filename << "\n";
+    return file;
+}
+
+bool writeColumns(std::FILE* file, const std::vector<const float*>& columns, std::size_t rows)
+{
+    for (const float* column : columns)
+    {
+        if (std::fwrite(column, sizeof(float), rows, file) != rows)
+            return false;
+    }
+    return true;
+}
+
+// Closes explicitly so a failed final flush is reported
+bool finish(FilePtr file, const std::string& filename, bool ok)
+{
+    ok = std::fclose(file.release()) == 0 && ok;
+    if (!ok)
+        std::cerr << "Failed to write " << filename << "\n";
+    return ok;
+}
+} // namespace
+
+bool writeNpy(
+    const std::string&               filename,
+    const std::vector<const float*>& columns,
+    std::size_t                      rows)
+{
+    FilePtr file = openForWriting(filename);
+    if (!file)
+        return false;
+
+    // Header dict padded with spaces so the data starts 64-byte aligned, as NumPy writes it
+    std::string header = std::string("{'descr': '")
+                         + (std::endian::native == std::endian::little ? "<f4" : ">f4")
+                         + "', 'fortran_order': True, 'shape': (" + std::to_string(rows) + ", "
+                         + std::to_string(columns.size()) + "), }";
+    const std::size_t prefix = 10; // magic (6), version (2), header length (2)
+    header.append(63 - (prefix + header.size()) % 64, ' ');
+    header.push_back('\n');
+
+    const auto          length       = static_cast<std::uint16_t>(header.size());
+    const unsigned char preamble[10] = {
+        0x93,
+        'N',
+        'U',
+        'M',
+        'P',
+        'Y',
+        1, // format 1.0
+        0,
+        static_cast<unsigned char>(length & 0xff), // little-endian header length
+        static_cast<unsigned char>(length >> 8)};
+
+    const bool ok = std::fwrite(preamble, 1, sizeof(preamble), file.get()) == sizeof(preamble)
+                    && std::fwrite(header.data(), 1, header.size(), file.get()) == header.size()
+                    && writeColumns(file.get(), columns, rows);
+    return finish(std::move(file), filename, ok);
+}
+
+bool writeRawFloat32(
+    const std::string&               filename,
+    const std::vector<const float*>& columns,
+    std::size_t                      rows)
+{
+    FilePtr file = openForWriting(filename);
+    if (!file)
+        return false;
+
+    const bool ok = writeColumns(file.get(), columns, rows);
+    return finish(std::move(file), filename, ok);
+}
+} // namespace ArrayWriter
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Binary dumps of float32 columns, one write per column (no per-value formatting or copying).
+namespace ArrayWriter
+{
+// NumPy .npy (format 1.0) with shape (rows, columns.size()) in Fortran order, so each column is
+// stored contiguously: `np.load(path)[:, k]` is columns[k]. Every column holds `rows` floats.
+bool writeNpy(
+    const std::string&               filename,
+    const std::vector<const float*>& columns,
+    std::size_t                      rows);
+
+// Raw native-endian float32, column after column (columns[0][0..rows), columns[1][0..rows), ...)
+bool writeRawFloat32(
+    const std::string&               filename,
+    const std::vector<const float*>& columns,
+    std::size_t                      rows);
+} // namespace ArrayWriter
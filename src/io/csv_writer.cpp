@@ -0,0 +1,138 @@
+#include "csv_writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+CsvWriter::CsvWriter(std::size_t bufferSize)
+    : m_buffer(std::max<std::size_t>(bufferSize, 4 * kMaxNumberChars))
+{
+}
+
+CsvWriter::~CsvWriter()
+{
+    close();
+}
+
+bool CsvWriter::open(const std::string& filename)
+{
+    close();
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file)
+    {
+        std::cerr << "Failed to open file: " << filename << "\n";
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IONBF, 0); // m_buffer already batches the writes
+    m_used     = 0;
+    m_rowStart = true;
+    m_failed   = false;
+    return true;
+}
+
+bool CsvWriter::close()
+{
+    if (!m_file)
+        return !m_failed;
+
+    flush();
+    m_failed |= std::fclose(m_file) != 0;
+    m_file = nullptr;
+    return !m_failed;
+}
+
+void CsvWriter::flush()
+{
+    if (m_used > 0 && m_file)
+        m_failed |= std::fwrite(m_buffer.data(), 1, m_used, m_file) != m_used;
+    m_used = 0;
+}
+
+void CsvWriter::reserve(std::size_t bytes)
+{
+    if (m_used + bytes > m_buffer.size())
+        flush();
+}
+
+void CsvWriter::separator()
+{
+    if (!m_rowStart)
+        m_buffer[m_used++] = ',';
+    m_rowStart = false;
+}
+
+template <typename T>
+CsvWriter& CsvWriter::number(T value)
+{
+    reserve(kMaxNumberChars);
+    separator();
+    char* const end = m_buffer.data() + m_buffer.size();
+    m_used          = std::to_chars(m_buffer.data() + m_used, end, value).ptr - m_buffer.data();
+    return *this;
+}
+
+CsvWriter& CsvWriter::field(float value)
+{
+    return number(value);
+}
+
+CsvWriter& CsvWriter::field(double value)
+{
+    return number(value);
+}
+
+CsvWriter& CsvWriter::field(std::int64_t value)
+{
+    return number(value);
+}
+
+CsvWriter& CsvWriter::field(std::uint64_t value)
+{
+    return number(value);
+}
+
+CsvWriter& CsvWriter::field(std::string_view text)
+{
+    const bool quote = text.find_first_of(",\"\r\n") != std::string_view::npos;
+    if (!quote && text.size() + 1 > m_buffer.size())
+    {
+        // Longer than the whole buffer: write it through
+        reserve(m_buffer.size());
+        separator();
+        flush();
+        if (m_file)
+            m_failed |= std::fwrite(text.data(), 1, text.size(), m_file) != text.size();
+        return *this;
+    }
+
+    if (!quote)
+    {
+        reserve(text.size() + 1);
+        separator();
+        std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+        m_used += text.size();
+        return *this;
+    }
+
+    reserve(2);
+    separator();
+    m_buffer[m_used++] = '"';
+    for (const char c : text)
+    {
+        reserve(2);
+        if (c == '"')
+            m_buffer[m_used++] = '"';
+        m_buffer[m_used++] = c;
+    }
+    reserve(1);
+    m_buffer[m_used++] = '"';
+    return *this;
+}
+
+void CsvWriter::endRow()
+{
+    reserve(1);
+    m_buffer[m_used++] = '\n';
+    m_rowStart         = true;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Buffered CSV output for large exports (inference results, descriptor tables).
+ *
+ * Numbers are formatted with `std::to_chars` straight into a large block that is written with
+ * one `fwrite` when full, instead of one formatted stream insertion per value. Output does not
+ * depend on the global locale. Floats use the shortest representation that reads back to the
+ * same value.
+ *
+ *     CsvWriter csv;
+ *     if (!csv.open("out.csv"))
+ *         return false;
+ *     csv.field(1.5f).field(-2.f).endRow();
+ *     return csv.close();
+ */
+class CsvWriter
+{
+  public:
+    explicit CsvWriter(std::size_t bufferSize = 1 << 20);
+    ~CsvWriter(); // closes the file; call close() to see whether everything was written
+
+    CsvWriter(const CsvWriter&)            = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    bool open(const std::string& filename);
+
+    // Flush and close; false if any write failed (disk full, ...)
+    bool close();
+
+    [[nodiscard]] bool isOpen() const
+    {
+        return m_file != nullptr;
+    }
+
+    CsvWriter& field(float value);
+    CsvWriter& field(double value);
+    CsvWriter& field(std::int64_t value);
+    CsvWriter& field(std::uint64_t value);
+    CsvWriter& field(int value)
+    {
+        return field(static_cast<std::int64_t>(value));
+    }
+    CsvWriter& field(unsigned value)
+    {
+        return field(static_cast<std::uint64_t>(value));
+    }
+
+    // Quoted (RFC 4180) when it contains a separator, quote or line break
+    CsvWriter& field(std::string_view text);
+
+    void endRow();
+
+    // A row of two floats, the common case for model outputs
+    void row(float a, float b)
+    {
+        field(a).field(b).endRow();
+    }
+
+  private:
+    // Room for any single number; strings longer than the buffer are written through
+    static constexpr std::size_t kMaxNumberChars = 32;
+
+    template <typename T>
+    CsvWriter& number(T value);
+
+    void separator();
+    void reserve(std::size_t bytes);
+    void flush();
+
+    std::FILE*        m_file = nullptr;
+    std::vector<char> m_buffer;
+    std::size_t       m_used     = 0;
+    bool              m_rowStart = true;
+    bool              m_failed   = false;
+};
@@ -5,18 +5,30 @@
 #include <TGUI/Backend/SFML-Graphics.hpp>
 #include <chrono>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <optional>
+#include <string>
 #include <vector>
 
-#include "modules/ai_inference/ModelProcessor.h"
+#include "atlas/texture_atlas.h"
+#include "modules/ai_inference/InferencePlot.h"
+#include "modules/ai_inference/InferencePlugin.h"
 #include "modules/kamon_fourier/kamon_fourier.h"
 #include "modules/logs_report/logs_report.h"
 #include "modules/mesh/mesh.h"
 #include "modules/tile/hexagon_tile.h"
 
+#include "render/render_scheduler.h"
 #include "screens/homepage_screen.h"
 #include "screens/welcome_screen.h"
+#include "startup/startup_scheduler.h"
+
+// Packed by the ui_atlas target into the build tree, which CMake passes in
+#ifndef LUCY_UI_ATLAS_FILE
+#define LUCY_UI_ATLAS_FILE "atlas/ui.atlas"
+#endif
 
 enum class Screen
 {
@@ -33,6 +45,16 @@ static void hideAllScreens(const std::vector<tgui::Panel::Ptr>& containers)
         c->setVisible(false);
 }
 
+// Error state of a screen whose assets could not be loaded
+static void showLoadError(const tgui::Panel::Ptr& container, const std::string& text)
+{
+    auto label = tgui::Label::create(text);
+    label->setTextSize(18);
+    label->getRenderer()->setTextColor(tgui::Color::Red);
+    label->setPosition({"(&.width - width)/2", "50%"});
+    container->add(label);
+}
+
 namespace RetroPalette
 {
 static const sf::Color LightGray     = sf::Color(192, 192, 192);
@@ -60,32 +82,32 @@ static const sf::Color PaleBlush     = sf::Color(238, 169, 169);
 static const unsigned WINDOW_WIDTH  = 900u;
 static const unsigned WINDOW_HEIGHT = 1000u;
 
-int main()
+static bool readBinaryFile(const std::string& path, std::vector<char>& data)
 {
-    // 0 - Model inference
-    const std::string model_path        = "assets/model/traced_model.pt";
-    const std::string csv_output_path   = "output.csv";
-    const std::string image_output_path = "output_plot.png";
-
-    ModelProcessor processor(model_path);
-
-    if (!processor.run())
-    {
-        std::cerr << "Failed to run model processing.\n";
-        return -1;
-    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return false;
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !data.empty();
+}
 
-    std::cout << "Processing complete.\n";
+int main()
+{
+    const auto startupBegin = std::chrono::steady_clock::now();
 
-    // ── 1) Window & GUI ───────────────────────────────────────
+    // ── 1) Window & GUI (up before anything heavy is loaded) ─
     sf::RenderWindow window(
         sf::VideoMode(sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT)),
         "Let's make Lucy amazing!",
         sf::Style::Close);
     window.setFramerateLimit(60);
 
-    tgui::Gui gui(window);
-    gui.setFont("assets/font/ChicagoKare-Regular.ttf");
+    tgui::Gui gui(window); // font is set once the startup scheduler has read it
+
+    // All UI sprites in one texture (built by the `ui_atlas` target)
+    TextureAtlas uiAtlas;
+    if (!uiAtlas.load(LUCY_UI_ATLAS_FILE))
+        std::cerr << "UI atlas missing, build the ui_atlas target.\n";
 
     // ── 2) Floating child‑windows (created first but *added* later)
     auto menuWindow    = tgui::ChildWindow::create("Menu");
@@ -94,18 +116,32 @@ int main()
     // ── 3) State variables ───────────────────────────────────
     Screen currentScreen = Screen::Home;
 
-    bool showGoodbye = false;
-    bool modeOnline  = false;
-    bool loading     = false;
+    bool showGoodbye   = false;
+    bool modeOnline    = false;
+    bool loading       = false;
+    bool meshReady     = false; // assets loaded by the startup scheduler
+    bool meshFailed    = false; // ... or not: the screen opens in its error state
+    bool fourierReady  = false;
+    bool fourierFailed = false;
 
     sf::Clock      loadingClock;
     const sf::Time LOADING_DURATION = sf::seconds(2.f);
 
+    // Inference (and libtorch) is only loaded once the log analysis screen is opened. The model
+    // then runs on the plugin's worker; its result arrives in InferenceEngine::deliver().
+    // The native export (pinn_export) needs no libtorch; the TorchScript model is the fallback.
+    InferencePlugin inferencePlugin;
+    const char*     modelPath        = std::filesystem::exists("assets/model/traced_model.mlp")
+                                           ? "assets/model/traced_model.mlp"
+                                           : "assets/model/traced_model.pt";
+    bool            inferenceHandled = false;
+    std::string     inferenceCost; // load time and memory of the plugin, shown on the logs screen
+
     // ── 4) Welcome screen ────────────────────────────────────
-    WelcomeScreen welcome(gui, window.getSize());
+    WelcomeScreen welcome(gui, uiAtlas, window.getSize());
     bool          welcomeHandled = false;
 
-    // ── 5) Screen containers ─────────────────────────────────
+    // ── 5) Screen containers (widgets only, assets arrive later) ─
     tgui::Panel::Ptr homeContainer;
     tgui::Panel::Ptr logAnalysisContainer;
     tgui::Panel::Ptr kamonFourierContainer;
@@ -114,16 +150,23 @@ int main()
     // Home screen (from new module)
     homeContainer = HomepageScreen::createHomepagePanel(
         window.getSize(),
+        uiAtlas,
         /* onLogsClick  */
         [&]()
         {
             loading = true;
             loadingClock.restart();
+            inferencePlugin.load(); // first use: overlaps with the loading screen
             std::cout << "[LOGS] Start loading...\n";
         },
         /* onMeshClick  */
         [&]()
         {
+            if (!meshReady && !meshFailed)
+            {
+                std::cout << "[Mesh] Still loading...\n";
+                return;
+            }
             currentScreen = Screen::Mesh;
             hideAllScreens(
                 {homeContainer, logAnalysisContainer, meshContainer, kamonFourierContainer});
@@ -132,6 +175,11 @@ int main()
         /* onFourierClick */
         [&]()
         {
+            if (!fourierReady && !fourierFailed)
+            {
+                std::cout << "[KamonFourier] Still loading...\n";
+                return;
+            }
             currentScreen = Screen::KamonFourier;
             hideAllScreens(
                 {homeContainer, logAnalysisContainer, meshContainer, kamonFourierContainer});
@@ -161,6 +209,16 @@ int main()
     logAnalysisContainer->setSize({(float)WINDOW_WIDTH, (float)WINDOW_HEIGHT});
     logAnalysisContainer->setVisible(false);
 
+    // Model output of the inference; drawn once when the result arrives
+    InferencePlot outputPlot({"100% - 100", 400});
+    outputPlot.widget()->setPosition(50, 450);
+    logAnalysisContainer->add(outputPlot.widget());
+
+    // What loading the inference plugin cost (filled in once it is loaded)
+    auto inferenceCostLabel = tgui::Label::create("Inference: loading...");
+    inferenceCostLabel->setPosition(50, 420);
+    logAnalysisContainer->add(inferenceCostLabel);
+
     meshContainer = Mesh::createMeshContainer(
         [&]()
         {
@@ -185,6 +243,8 @@ int main()
         });
     kamonFourierContainer->setSize({(float)WINDOW_WIDTH, (float)WINDOW_HEIGHT});
     kamonFourierContainer->setVisible(false);
+    if (uiAtlas.isLoaded())
+        KamonFourier::setBackground(uiAtlas.texture(), uiAtlas.rect("niwa"));
 
     // ── 6) Add *panel* widgets first (they form the background) ─
     gui.add(homeContainer);
@@ -258,16 +318,51 @@ int main()
     exitBtn->onPress([&]() { window.close(); });
     goodbyePanel->add(exitBtn);
 
-    // ── 10) Main loop ────────────────────────────────────────
+    // ── 10) Startup work on worker threads ──────────────────
+    // Everything the tasks touch is declared before the scheduler, whose destructor waits
+    // for running tasks.
+    std::vector<char> fontData;
+
+    StartupScheduler startup;
+    startup.add(
+        "font",
+        [&] { return readBinaryFile("assets/font/ChicagoKare-Regular.ttf", fontData); },
+        {},
+        [&] { gui.setFont(tgui::Font(fontData.data(), fontData.size())); });
+    startup.add(
+        "meshes",
+        [] { return Mesh::loadAssets(); },
+        {},
+        [&] { meshReady = true; },
+        [&]
+        {
+            meshFailed = true;
+            showLoadError(meshContainer, "Mesh data could not be loaded (see log)");
+        });
+    startup.add(
+        "kamon",
+        [] { return KamonFourier::preloadAssets(); },
+        {},
+        [&] { fourierReady = true; },
+        [&]
+        {
+            fourierFailed = true;
+            showLoadError(kamonFourierContainer, "Kamon contours could not be loaded (see log)");
+        });
+    startup.start();
+
+    // ── 11) Main loop ────────────────────────────────────────
+    // Frames are drawn only when something changed or an animation runs; otherwise the loop
+    // sleeps in waitEvent() and wakes a few times per second to poll the background work.
+    RenderScheduler render;
+    bool            startupReported = false;
     while (window.isOpen())
     {
-        // Event polling
-        while (true)
+        // Event handling: block until input or the next wake-up unless a frame is due
+        std::optional<sf::Event> optEvent =
+            render.frameDue() ? window.pollEvent() : window.waitEvent(render.waitTimeout());
+        for (; optEvent.has_value(); optEvent = window.pollEvent())
         {
-            std::optional<sf::Event> optEvent = window.pollEvent();
-            if (!optEvent.has_value())
-                break;
-
             if (optEvent->is<sf::Event::Closed>())
             {
                 window.close();
@@ -275,18 +370,87 @@ int main()
             }
 
             gui.handleEvent(*optEvent);
+            render.invalidate(); // hover, focus, clicks... let the GUI redraw
         }
         if (!window.isOpen())
             break;
 
+        // GUI timers, animations and the blinking text cursor
+        if (gui.updateTime())
+            render.invalidate();
+
+        // Deliver finished startup tasks (font, screen availability) and inference results.
+        // Their callbacks touch widgets, so redraw while any are outstanding.
+        if (!startup.finished())
+        {
+            startup.poll();
+            render.invalidate();
+        }
+
+        InferenceEngine* inference = inferencePlugin.engine();
+        if (inference && !inferenceHandled)
+        {
+            inferenceHandled = true;
+            const std::size_t rssMiB = inferencePlugin.rssDeltaBytes() >> 20;
+            std::cout << "[Inference] Plugin loaded in " << inferencePlugin.loadMs()
+                      << " ms, RSS +" << rssMiB << " MiB\n";
+            inferenceCost = "Inference plugin: "
+                            + std::to_string(static_cast<int>(inferencePlugin.loadMs()))
+                            + " ms to load, +" + std::to_string(rssMiB) + " MiB resident";
+
+            inference->submit(
+                {modelPath},
+                [&](const InferenceResult& result)
+                {
+                    if (result.ok)
+                    {
+                        std::cout << "Processing complete (" << result.ms << " ms).\n";
+                        outputPlot.setSeries(
+                            result.inputs,
+                            result.output_col1,
+                            result.output_col2,
+                            result.y_min,
+                            result.y_max);
+                        render.invalidate();
+                    }
+                    else if (!result.cancelled)
+                        std::cerr << "Failed to run model processing.\n";
+                });
+        }
+        else if (!inference && inferencePlugin.failed() && !inferenceHandled)
+        {
+            inferenceHandled = true;
+            inferenceCostLabel->setText("Inference plugin could not be loaded");
+            render.invalidate();
+        }
+        if (inference)
+        {
+            inference->deliver();
+
+            // Plugin cost, plus the model's progress while it runs
+            std::string text = inferenceCost;
+            if (inference->runningId() != 0)
+            {
+                const int percent = static_cast<int>(inference->progress() * 100.f);
+                text += "  |  model " + std::to_string(percent) + "%";
+            }
+            if (inferenceCostLabel->getText() != text)
+            {
+                inferenceCostLabel->setText(text);
+                render.invalidate();
+            }
+        }
+
         // Welcome screen logic only (no sparkle drawing here)
         if (!welcomeHandled)
         {
+            welcome.setStatus(startup.status());
             welcome.update(window);
             if (!welcome.isActive())
             {
                 homeContainer->setVisible(true);
                 welcomeHandled = true;
+                render.invalidate();
             }
         }
 
@@ -300,13 +464,21 @@ int main()
                 hideAllScreens(
                     {homeContainer, logAnalysisContainer, meshContainer, kamonFourierContainer});
                 logAnalysisContainer->setVisible(true);
+                render.invalidate();
                 std::cout << "[LOGS] Done loading, switch to LogAnalysis screen.\n";
             }
+            else
+                render.wakeAfter(std::chrono::microseconds(
+                    (LOADING_DURATION - loadingClock.getElapsedTime()).asMicroseconds()));
         }
 
         goodbyeWindow->setVisible(showGoodbye);
 
+        if (!render.frameDue())
+            continue;
+
         // Render
+        render.beginFrame();
         window.clear(RetroPalette::LightGray);
         window.setView(window.getDefaultView());
 
@@ -327,7 +499,30 @@ int main()
         }
 
         window.display();
+
+        // Animations ask for the next frame for as long as they run
+        const bool welcomeAnimating = !welcomeHandled && welcome.isActive();
+        const bool fourierAnimating = currentScreen == Screen::KamonFourier && fourierReady;
+        const bool meshAnimating    = currentScreen == Screen::Mesh && Mesh::isAnimating();
+        if (welcomeAnimating || fourierAnimating || meshAnimating)
+            render.requestFrame();
+
+        if (!startupReported)
+        {
+            // Baseline for the plugin's numbers above: the app without inference loaded
+            startupReported = true;
+            const double ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - startupBegin)
+                                  .count();
+            std::cout << "[Startup] First frame after " << ms << " ms, RSS "
+                      << (InferencePlugin::residentBytes() >> 20)
+                      << " MiB (inference not loaded)\n";
+        }
     }
 
+    std::cout << "[Render] " << render.framesDrawn() << " frames drawn in "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - startupBegin)
+                     .count()
+              << " s\n";
     return 0;
 }
@@ -0,0 +1,96 @@
+#include "AdaptiveGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+AdaptiveGrid::AdaptiveGrid(int num_steps, const Options& options)
+    : options_(options)
+{
+    if (num_steps <= 0)
+        return;
+
+    const int last      = num_steps - 1;
+    const int intervals = std::clamp(options.initial_intervals, 1, std::max(last, 1));
+    for (int k = 0; k <= intervals; ++k)
+    {
+        const int step = static_cast<int>(static_cast<long long>(k) * last / intervals);
+        if (pending_.empty() || step != pending_.back())
+            pending_.push_back(step);
+    }
+}
+
+void AdaptiveGrid::accept(const float* col1, const float* col2)
+{
+    // Merge the new level into the (sorted) evaluated steps
+    std::vector<int>   steps;
+    std::vector<float> out1, out2;
+    const std::size_t  total = steps_.size() + pending_.size();
+    steps.reserve(total);
+    out1.reserve(total);
+    out2.reserve(total);
+
+    std::size_t i = 0, j = 0;
+    while (i < steps_.size() || j < pending_.size())
+    {
+        if (j == pending_.size() || (i < steps_.size() && steps_[i] < pending_[j]))
+        {
+            steps.push_back(steps_[i]);
+            out1.push_back(col1_[i]);
+            out2.push_back(col2_[i]);
+            ++i;
+        }
+        else
+        {
+            steps.push_back(pending_[j]);
+            out1.push_back(col1[j]);
+            out2.push_back(col2[j]);
+            ++j;
+        }
+    }
+    steps_.swap(steps);
+    col1_.swap(out1);
+    col2_.swap(out2);
+    ++levels_;
+
+    selectNextLevel();
+}
+
+void AdaptiveGrid::selectNextLevel()
+{
+    pending_.clear();
+    const std::size_t n = steps_.size();
+    if (levels_ > options_.max_levels || n < 2)
+        return;
+
+    const auto [min1, max1] = std::minmax_element(col1_.begin(), col1_.end());
+    const auto [min2, max2] = std::minmax_element(col2_.begin(), col2_.end());
+    const float range       = std::max(std::max(*max1, *max2) - std::min(*min1, *min2), 1e-12f);
+    const float max_step    = options_.step_tolerance * range;
+    const float max_bend    = options_.curvature_tolerance * range;
+
+    // refine[k]: bisect the interval between samples k and k + 1
+    std::vector<char> refine(n - 1, 0);
+    for (std::size_t k = 0; k + 1 < n; ++k)
+    {
+        if (std::fabs(col1_[k + 1] - col1_[k]) > max_step
+            || std::fabs(col2_[k + 1] - col2_[k]) > max_step)
+            refine[k] = 1;
+    }
+    for (std::size_t k = 1; k + 1 < n; ++k)
+    {
+        // Distance of sample k from the chord through its neighbours (steps are the x axis)
+        const float t =
+            static_cast<float>(steps_[k] - steps_[k - 1]) / (steps_[k + 1] - steps_[k - 1]);
+        const float bend1 = col1_[k] - (col1_[k - 1] + t * (col1_[k + 1] - col1_[k - 1]));
+        const float bend2 = col2_[k] - (col2_[k - 1] + t * (col2_[k + 1] - col2_[k - 1]));
+        if (std::fabs(bend1) > max_bend || std::fabs(bend2) > max_bend)
+            refine[k - 1] = refine[k] = 1;
+    }
+
+    for (std::size_t k = 0; k + 1 < n; ++k)
+    {
+        if (refine[k] && steps_[k + 1] - steps_[k] >= 2)
+            pending_.push_back(steps_[k] + (steps_[k + 1] - steps_[k]) / 2);
+    }
+}
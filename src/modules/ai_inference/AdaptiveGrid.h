@@ -0,0 +1,71 @@
+#ifndef ADAPTIVE_GRID_H
+#define ADAPTIVE_GRID_H
+
+#include <vector>
+
+/**
+ * Level-by-level refinement of a subset of the uniform grid steps 0 .. num_steps - 1.
+ *
+ * Starts from a coarse uniform subset and, after each level has been evaluated, bisects every
+ * interval whose outputs change too much between its ends or that borders a sample lying too far
+ * off the straight line through its neighbours. Refinement stops at adjacent grid steps, so the
+ * result is always a subset of the uniform grid and never finer than it.
+ *
+ * The grid only chooses steps; the caller evaluates each pending() level in one batch and hands
+ * the outputs back through accept(). Features narrower than the coarse spacing can be missed
+ * entirely, so `initial_intervals` has to resolve the narrowest one.
+ */
+class AdaptiveGrid
+{
+  public:
+    struct Options
+    {
+        int initial_intervals = 256; // uniform coarse level
+        int max_levels        = 16;  // refinement levels after the coarse one
+
+        // Both relative to the output range seen so far (both columns)
+        float curvature_tolerance = 1e-3f; // |sample - line through its neighbours|
+        float step_tolerance      = 0.02f; // |difference between neighbouring samples|
+    };
+
+    AdaptiveGrid(int num_steps, const Options& options);
+
+    // Grid steps of the next level, ascending; empty once refinement has finished
+    const std::vector<int>& pending() const
+    {
+        return pending_;
+    }
+
+    // Outputs for pending(), in the same order; merges them and selects the next level
+    void accept(const float* col1, const float* col2);
+
+    // All evaluated steps, ascending, with their outputs
+    const std::vector<int>& steps() const
+    {
+        return steps_;
+    }
+    const std::vector<float>& col1() const
+    {
+        return col1_;
+    }
+    const std::vector<float>& col2() const
+    {
+        return col2_;
+    }
+    int levels() const
+    {
+        return levels_;
+    }
+
+  private:
+    void selectNextLevel();
+
+    Options            options_;
+    std::vector<int>   pending_;
+    std::vector<int>   steps_;
+    std::vector<float> col1_;
+    std::vector<float> col2_;
+    int                levels_ = 0; // levels accepted so far
+};
+
+#endif // ADAPTIVE_GRID_H
@@ -0,0 +1,25 @@
+#include "InferenceBackend.h"
+
+#include "NativeMlp.h"
+#ifdef LUCY_WITH_TORCH
+#include "TorchBackend.h"
+#endif
+
+#include <iostream>
+
+std::unique_ptr<InferenceBackend> InferenceBackend::load(
+    const std::string& model_path,
+    Optimization       optimization)
+{
+    if (NativeMlp::isNativeFile(model_path))
+        return NativeMlp::load(model_path);
+
+#ifdef LUCY_WITH_TORCH
+    return TorchBackend::load(model_path, optimization);
+#else
+    (void)optimization;
+    std::cerr << model_path << " is not a native model and this build has no libtorch "
+              << "(convert it with pinn_export)\n";
+    return nullptr;
+#endif
+}
@@ -0,0 +1,50 @@
+#ifndef INFERENCE_BACKEND_H
+#define INFERENCE_BACKEND_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * What ModelProcessor runs a model with.
+ *
+ * A backend maps `count` scalar inputs to the first two output columns; everything around it
+ * (grids, chunking, caching, writers) stays in ModelProcessor. load() picks the implementation
+ * from the file: exported native weights (NativeMlp, see pinn_export) need nothing but this
+ * library, TorchScript files need a build with LUCY_WITH_TORCH.
+ */
+class InferenceBackend
+{
+  public:
+    enum class Optimization
+    {
+        None,       // the traced module as loaded, in eval mode
+        Frozen,     // torch::jit::freeze + optimize_for_inference
+        DynamicInt8 // int8 dense layers (ModelOptimizer::QuantizedMlp)
+    };
+
+    virtual ~InferenceBackend() = default;
+
+    // nullptr (with a message on std::cerr) if the file cannot be loaded. `optimization` only
+    // applies to TorchScript models; native models are always run as exported.
+    static std::unique_ptr<InferenceBackend> load(
+        const std::string& model_path,
+        Optimization       optimization);
+
+    // Writes `count` values to each of col1 / col2 and widens [y_min, y_max] to cover them (a
+    // vectorised reduction in each backend); false on error
+    virtual bool forward(
+        const float* input,
+        int          count,
+        float*       col1,
+        float*       col2,
+        float&       y_min,
+        float&       y_max) = 0;
+
+    // Bytes held by the weights as run (after optimisation)
+    virtual std::size_t weightBytes() const = 0;
+
+    virtual const char* name() const = 0;
+};
+
+#endif // INFERENCE_BACKEND_H
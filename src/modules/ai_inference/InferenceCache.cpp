@@ -0,0 +1,227 @@
+#include "InferenceCache.h"
+
+#ifdef LUCY_WITH_TORCH
+#include <torch/version.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INFERENCE_CACHE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace InferenceCache
+{
+namespace
+{
+constexpr char          kMagic[4]      = {'P', 'I', 'C', '1'};
+constexpr std::uint32_t kFormatVersion = 1;
+constexpr std::size_t   kHeaderSize    = 64; // columns start cache-line aligned
+constexpr std::uint64_t kFnvOffset     = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime      = 1099511628211ull;
+
+struct Header
+{
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t key;
+    std::uint64_t count;
+    float         y_min;
+    float         y_max;
+};
+static_assert(sizeof(Header) <= kHeaderSize);
+
+void fnv1a(std::uint64_t& hash, const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+}
+
+fs::path cacheFile(const std::string& cacheDir, std::uint64_t key)
+{
+    char name[40];
+    std::snprintf(name, sizeof(name), "pinn_%016llx.bin", static_cast<unsigned long long>(key));
+    return fs::path(cacheDir) / name;
+}
+
+// Read-only view of a whole file: a private mapping where available, a plain read elsewhere
+class FileView
+{
+  public:
+    explicit FileView(const fs::path& path)
+    {
+#ifdef INFERENCE_CACHE_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED)
+            {
+                data_ = static_cast<const char*>(map);
+                size_ = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd); // the mapping stays valid
+#else
+        std::ifstream in(path, std::ios::binary);
+        bytes_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = bytes_.data();
+        size_ = bytes_.size();
+#endif
+    }
+
+    ~FileView()
+    {
+#ifdef INFERENCE_CACHE_MMAP
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    FileView(const FileView&)            = delete;
+    FileView& operator=(const FileView&) = delete;
+
+    const char* data() const
+    {
+        return data_;
+    }
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+  private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifndef INFERENCE_CACHE_MMAP
+    std::vector<char> bytes_;
+#endif
+};
+} // namespace
+
+std::uint64_t
+makeKey(const std::string& modelPath, int numSteps, double stepSize, std::uint32_t variant)
+{
+    std::ifstream in(modelPath, std::ios::binary);
+    if (!in.is_open())
+        return 0;
+
+    std::uint64_t           hash = kFnvOffset;
+    std::array<char, 65536> buf;
+    while (in.read(buf.data(), buf.size()) || in.gcount() > 0)
+        fnv1a(hash, buf.data(), static_cast<std::size_t>(in.gcount()));
+
+    const std::int64_t steps = numSteps;
+    fnv1a(hash, &kFormatVersion, sizeof(kFormatVersion));
+    fnv1a(hash, &steps, sizeof(steps));
+    fnv1a(hash, &stepSize, sizeof(stepSize));
+    fnv1a(hash, &variant, sizeof(variant));
+
+#ifdef LUCY_WITH_TORCH
+    // A different libtorch may produce (slightly) different numbers for the same model
+    const char torchVersion[] = TORCH_VERSION;
+    fnv1a(hash, torchVersion, sizeof(torchVersion));
+#endif
+
+    return hash != 0 ? hash : 1;
+}
+
+bool load(const std::string& cacheDir, std::uint64_t key, Entry& entry)
+{
+    const FileView file(cacheFile(cacheDir, key));
+    if (!file.data())
+        return false;
+
+    Header header{};
+    if (file.size() >= kHeaderSize)
+        std::memcpy(&header, file.data(), sizeof(header));
+
+    if (file.size() < kHeaderSize || !std::equal(kMagic, kMagic + 4, header.magic)
+        || header.version != kFormatVersion || header.key != key
+        || header.count != (file.size() - kHeaderSize) / (2 * sizeof(float))
+        || (file.size() - kHeaderSize) % (2 * sizeof(float)) != 0)
+    {
+        std::cerr << "Ignoring stale inference cache file for key " << key << "\n";
+        return false;
+    }
+
+    const auto* col1 = reinterpret_cast<const float*>(file.data() + kHeaderSize);
+    const auto* col2 = col1 + header.count;
+    entry.output_col1.assign(col1, col1 + header.count);
+    entry.output_col2.assign(col2, col2 + header.count);
+    entry.y_min = header.y_min;
+    entry.y_max = header.y_max;
+    return true;
+}
+
+bool store(
+    const std::string&        cacheDir,
+    std::uint64_t             key,
+    const std::vector<float>& outputCol1,
+    const std::vector<float>& outputCol2,
+    float                     yMin,
+    float                     yMax)
+{
+    if (outputCol1.size() != outputCol2.size())
+        return false;
+
+    std::error_code ec;
+    fs::create_directories(cacheDir, ec);
+
+    // Write to a temporary name first so a crash never leaves a half-written entry behind
+    const fs::path target = cacheFile(cacheDir, key);
+    const fs::path tmp    = fs::path(target).concat(".tmp");
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out.is_open())
+        {
+            std::cerr << "Failed to write inference cache file: " << tmp << "\n";
+            return false;
+        }
+
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.key     = key;
+        header.count   = outputCol1.size();
+        header.y_min   = yMin;
+        header.y_max   = yMax;
+
+        std::array<char, kHeaderSize> block{};
+        std::memcpy(block.data(), &header, sizeof(header));
+        out.write(block.data(), block.size());
+        out.write(
+            reinterpret_cast<const char*>(outputCol1.data()),
+            static_cast<std::streamsize>(outputCol1.size() * sizeof(float)));
+        out.write(
+            reinterpret_cast<const char*>(outputCol2.data()),
+            static_cast<std::streamsize>(outputCol2.size() * sizeof(float)));
+        if (!out)
+            return false;
+    }
+
+    fs::rename(tmp, target, ec);
+    return !ec;
+}
+
+} // namespace InferenceCache
@@ -0,0 +1,43 @@
+#ifndef INFERENCE_CACHE_H
+#define INFERENCE_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk cache of ModelProcessor results, so an unchanged model is never re-evaluated.
+//
+// File layout (native endianness, one file per key):
+//   64-byte header: magic "PIC1", format version, key, step count, y_min, y_max, zero padding
+//   float32 col1[count], then float32 col2[count]
+// The columns start 64-byte aligned, so the file can be mapped and read in place.
+namespace InferenceCache
+{
+struct Entry
+{
+    std::vector<float> output_col1;
+    std::vector<float> output_col2;
+    float              y_min = 0.f;
+    float              y_max = 0.f;
+};
+
+// 64-bit FNV-1a over the model file bytes, the input grid definition (step count and step size),
+// the model variant (ModelProcessor::Optimization, which changes the numbers) and, in builds with
+// LUCY_WITH_TORCH, the libtorch version. Returns 0 if the model cannot be read.
+std::uint64_t
+makeKey(const std::string& modelPath, int numSteps, double stepSize, std::uint32_t variant = 0);
+
+// Map the cache file for `key` from `cacheDir`; false on miss or mismatch
+bool load(const std::string& cacheDir, std::uint64_t key, Entry& entry);
+
+// Write the cache file for `key` into `cacheDir` (created if missing)
+bool store(
+    const std::string&        cacheDir,
+    std::uint64_t             key,
+    const std::vector<float>& outputCol1,
+    const std::vector<float>& outputCol2,
+    float                     yMin,
+    float                     yMax);
+} // namespace InferenceCache
+
+#endif // INFERENCE_CACHE_H
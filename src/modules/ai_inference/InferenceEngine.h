@@ -0,0 +1,96 @@
+#ifndef INFERENCE_ENGINE_H
+#define INFERENCE_ENGINE_H
+
+#include "AdaptiveGrid.h"
+#include "InferenceBackend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct InferenceRequest
+{
+    std::string model_path;
+    int         num_steps  = 40000;
+    int         chunk_size = 4096; // steps per forward pass; progress / cancel granularity
+
+    // Non-empty: stream the outputs to this file (ModelProcessor::stream) instead of returning
+    // them; the result then carries only y_min / y_max. Memory stays at one chunk.
+    std::string output_path;
+    bool        binary_output = false; // raw float32 pairs instead of CSV
+
+    InferenceBackend::Optimization optimization = InferenceBackend::Optimization::None;
+
+    // In-memory requests only: evaluate the steps AdaptiveGrid picks instead of the whole grid
+    // (ModelProcessor::inferAdaptive); a cached full grid still wins. Progress then counts the
+    // evaluated steps against the full grid.
+    bool                  adaptive = false;
+    AdaptiveGrid::Options adaptive_options;
+
+    // Result cache for in-memory requests (ModelProcessor::loadCached); empty disables it
+    std::string cache_dir = ".cache/ai_inference";
+};
+
+struct InferenceResult
+{
+    std::uint64_t      id        = 0;
+    bool               ok        = false;
+    bool               cancelled = false;
+    std::vector<float> inputs;
+    std::vector<float> output_col1;
+    std::vector<float> output_col2;
+    float              y_min = 0.f;
+    float              y_max = 0.f;
+    double             ms    = 0.0; // load + inference wall time
+};
+
+/**
+ * Asynchronous inference as seen by the app.
+ *
+ * Implemented by InferenceService inside the inference plugin; the app only ever calls it
+ * through this interface (InferencePlugin), so it never links ModelProcessor or libtorch.
+ */
+class InferenceEngine
+{
+  public:
+    using Callback  = std::function<void(const InferenceResult&)>;
+    using ResultPtr = std::shared_ptr<const InferenceResult>;
+
+    struct Ticket
+    {
+        std::uint64_t          id = 0;
+        std::future<ResultPtr> result;
+    };
+
+    virtual ~InferenceEngine() = default;
+
+    // Queue a request; std::nullopt if the engine is at capacity
+    virtual std::optional<Ticket> submit(InferenceRequest request, Callback on_done = {}) = 0;
+
+    // Cancel a queued request, or stop the running one after its current chunk
+    virtual bool cancel(std::uint64_t id) = 0;
+
+    // UI thread: run the callbacks of finished requests
+    virtual void deliver() = 0;
+
+    // Progress of the running request (0..1) and its id (0 = idle)
+    virtual float         progress() const  = 0;
+    virtual std::uint64_t runningId() const = 0;
+};
+
+// Bumped whenever this header changes; the plugin and the app must agree on it
+constexpr int kInferenceAbiVersion = 1;
+
+// Entry points of the inference plugin, resolved by InferencePlugin with dlsym
+extern "C"
+{
+    int              lucy_inference_abi_version();
+    InferenceEngine* lucy_inference_create(std::size_t capacity);
+}
+
+#endif // INFERENCE_ENGINE_H
@@ -0,0 +1,94 @@
+#include "InferencePlot.h"
+
+#include <algorithm>
+
+namespace
+{
+const sf::Color kBackground(255, 255, 255);
+const sf::Color kGrid(240, 240, 240);
+const sf::Color kAxis(0, 0, 0);
+const sf::Color kCol1(255, 0, 0);
+const sf::Color kCol2(0, 0, 255);
+constexpr float kGridSpacing = 50.f;
+} // namespace
+
+InferencePlot::InferencePlot(const tgui::Layout2d& size)
+    : canvas_(tgui::CanvasSFML::create(size))
+{
+    canvas_->onSizeChange([this] { redraw(); });
+    redraw();
+}
+
+InferencePlot::~InferencePlot()
+{
+    canvas_->onSizeChange.disconnectAll();
+}
+
+void InferencePlot::setSeries(
+    const std::vector<float>& x,
+    const std::vector<float>& col1,
+    const std::vector<float>& col2,
+    float                     y_min,
+    float                     y_max)
+{
+    x_     = x;
+    col1_  = col1;
+    col2_  = col2;
+    y_min_ = y_min;
+    y_max_ = y_max;
+    redraw();
+}
+
+void InferencePlot::redraw()
+{
+    const tgui::Vector2f size    = canvas_->getSize();
+    const float          width   = size.x;
+    const float          height  = size.y;
+    const int            columns = static_cast<int>(width);
+
+    canvas_->clear(kBackground);
+
+    // Gridlines and axes
+    sf::VertexArray frame(sf::PrimitiveType::Lines);
+
+    auto segment = [&](sf::Vector2f a, sf::Vector2f b, sf::Color color)
+    {
+        frame.append(sf::Vertex{a, color});
+        frame.append(sf::Vertex{b, color});
+    };
+    for (float x = 0.f; x < width; x += kGridSpacing)
+        segment({x + 0.5f, 0.f}, {x + 0.5f, height}, kGrid);
+    for (float y = 0.f; y < height; y += kGridSpacing)
+        segment({0.f, y + 0.5f}, {width, y + 0.5f}, kGrid);
+    segment({0.f, height - 0.5f}, {width, height - 0.5f}, kAxis);
+    segment({0.5f, 0.f}, {0.5f, height}, kAxis);
+    canvas_->draw(frame);
+
+    const std::size_t count = std::min({x_.size(), col1_.size(), col2_.size()});
+    if (count > 0 && columns > 1)
+    {
+        const float x_min   = x_.front();
+        const float x_max   = x_[count - 1];
+        const float x_scale = x_max > x_min ? (width - 1.f) / (x_max - x_min) : 0.f;
+        const float y_range = y_max_ > y_min_ ? y_max_ - y_min_ : 1.f;
+
+        auto drawSeries = [&](const std::vector<float>& y, sf::Color color)
+        {
+            SeriesDecimator::decimate(
+                x_.data(), y.data(), count, x_min, x_max, columns, decimated_);
+            line_.clear();
+            for (const auto& p : decimated_)
+            {
+                const sf::Vector2f position(
+                    (p.x - x_min) * x_scale + 0.5f,
+                    height - 0.5f - (p.y - y_min_) / y_range * (height - 1.f));
+                line_.append(sf::Vertex{position, color});
+            }
+            canvas_->draw(line_);
+        };
+        drawSeries(col1_, kCol1);
+        drawSeries(col2_, kCol2);
+    }
+
+    canvas_->display();
+}
@@ -0,0 +1,54 @@
+#ifndef INFERENCE_PLOT_H
+#define INFERENCE_PLOT_H
+
+#include "SeriesDecimator.h"
+
+#include <SFML/Graphics.hpp>
+#include <TGUI/AllWidgets.hpp>
+#include <TGUI/Backend/SFML-Graphics.hpp>
+
+#include <vector>
+
+/**
+ * In-app line plot of the two PINN output columns.
+ *
+ * Draws into a tgui::CanvasSFML only when the data or the canvas size changes; each series is
+ * first decimated to the canvas width (SeriesDecimator), so a redraw costs at most four vertices
+ * per pixel column however long the grid is. Same colours as ModelProcessor::plotOutput.
+ */
+class InferencePlot
+{
+  public:
+    explicit InferencePlot(const tgui::Layout2d& size);
+    ~InferencePlot(); // the GUI may outlive the plot: detaches from the canvas
+
+    InferencePlot(const InferencePlot&)            = delete;
+    InferencePlot& operator=(const InferencePlot&) = delete;
+
+    tgui::CanvasSFML::Ptr widget() const
+    {
+        return canvas_;
+    }
+
+    // `x` must be sorted; the series are copied so the plot can be redrawn at a new size
+    void setSeries(
+        const std::vector<float>& x,
+        const std::vector<float>& col1,
+        const std::vector<float>& col2,
+        float                     y_min,
+        float                     y_max);
+
+  private:
+    void redraw();
+
+    tgui::CanvasSFML::Ptr               canvas_;
+    std::vector<float>                  x_;
+    std::vector<float>                  col1_;
+    std::vector<float>                  col2_;
+    float                               y_min_ = 0.f;
+    float                               y_max_ = 0.f;
+    std::vector<SeriesDecimator::Point> decimated_;
+    sf::VertexArray                     line_{sf::PrimitiveType::LineStrip};
+};
+
+#endif // INFERENCE_PLOT_H
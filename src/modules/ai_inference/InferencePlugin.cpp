@@ -0,0 +1,142 @@
+#include "InferencePlugin.h"
+
+#include <dlfcn.h>
+
+#if defined(__APPLE__)
+#include <mach-o/dyld.h>
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// File name of the plugin target, set by CMake (a MODULE library is a .so on macOS as well)
+#ifndef LUCY_INFERENCE_PLUGIN_FILE
+#define LUCY_INFERENCE_PLUGIN_FILE "liblucy_inference.so"
+#endif
+
+namespace
+{
+using AbiVersionFn = int (*)();
+using CreateFn     = InferenceEngine* (*)(std::size_t);
+
+std::filesystem::path executableDir()
+{
+    std::error_code ec;
+#if defined(__APPLE__)
+    std::uint32_t size = 0;
+    _NSGetExecutablePath(nullptr, &size);
+    std::vector<char> buffer(size + 1, '\0');
+    if (_NSGetExecutablePath(buffer.data(), &size) != 0)
+        return {};
+    const std::filesystem::path exe = std::filesystem::weakly_canonical(buffer.data(), ec);
+#else
+    const std::filesystem::path exe = std::filesystem::read_symlink("/proc/self/exe", ec);
+#endif
+    return ec ? std::filesystem::path() : exe.parent_path();
+}
+
+std::string pluginPath()
+{
+    if (const char* env = std::getenv("LUCY_INFERENCE_PLUGIN"); env && *env)
+        return env;
+    return (executableDir() / LUCY_INFERENCE_PLUGIN_FILE).string();
+}
+} // namespace
+
+InferencePlugin::InferencePlugin(std::size_t capacity) : capacity_(capacity) {}
+
+InferencePlugin::~InferencePlugin()
+{
+    // A load still in flight must finish before its result (and the engine) can be destroyed
+    if (pending_.valid())
+        pending_.wait();
+}
+
+void InferencePlugin::load()
+{
+    if (requested_)
+        return;
+    requested_ = true;
+    pending_   = std::async(std::launch::async, &InferencePlugin::open, capacity_);
+}
+
+InferenceEngine* InferencePlugin::engine()
+{
+    if (pending_.valid()
+        && pending_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        Loaded loaded = pending_.get();
+        engine_       = std::move(loaded.engine);
+        load_ms_      = loaded.ms;
+        rss_delta_    = loaded.rss_delta;
+        failed_       = !engine_;
+    }
+    return engine_.get();
+}
+
+InferencePlugin::Loaded InferencePlugin::open(std::size_t capacity)
+{
+    Loaded            loaded;
+    const std::string path      = pluginPath();
+    const std::size_t rssBefore = residentBytes();
+    const auto        start     = std::chrono::steady_clock::now();
+
+    // RTLD_LOCAL: nothing of the plugin (or libtorch) leaks into the app's symbol lookup
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+    {
+        std::cerr << "Inference plugin: " << dlerror() << '\n';
+        return loaded;
+    }
+
+    const auto abiVersion =
+        reinterpret_cast<AbiVersionFn>(dlsym(handle, "lucy_inference_abi_version"));
+    const auto create = reinterpret_cast<CreateFn>(dlsym(handle, "lucy_inference_create"));
+    if (!abiVersion || !create)
+    {
+        std::cerr << "Inference plugin: " << path << " has no inference entry points\n";
+        return loaded;
+    }
+    if (abiVersion() != kInferenceAbiVersion)
+    {
+        std::cerr << "Inference plugin: " << path << " has ABI version " << abiVersion()
+                  << ", expected " << kInferenceAbiVersion << '\n';
+        return loaded;
+    }
+
+    loaded.engine.reset(create(capacity));
+    loaded.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                    .count();
+
+    const std::size_t rssAfter = residentBytes();
+    loaded.rss_delta           = rssAfter > rssBefore ? rssAfter - rssBefore : 0;
+    return loaded;
+}
+
+std::size_t InferencePlugin::residentBytes()
+{
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t      count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(
+            mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count)
+        != KERN_SUCCESS)
+        return 0;
+    return static_cast<std::size_t>(info.resident_size);
+#else
+    // statm: total and resident size in pages
+    std::ifstream statm("/proc/self/statm");
+    std::size_t   pages = 0, resident = 0;
+    if (!(statm >> pages >> resident))
+        return 0;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
@@ -0,0 +1,80 @@
+#ifndef INFERENCE_PLUGIN_H
+#define INFERENCE_PLUGIN_H
+
+#include "InferenceEngine.h"
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+
+/**
+ * Loads the inference plugin (lucy_inference: InferenceService, ModelProcessor and, with
+ * LUCY_WITH_TORCH, libtorch) the first time a feature asks for it.
+ *
+ * The app itself does not link any of that, so startup and resident memory stay free of
+ * libtorch until load() is called. load() opens the library on a background thread; engine()
+ * returns nullptr until it is ready and is cheap to call every frame. The plugin is looked up
+ * next to the executable unless LUCY_INFERENCE_PLUGIN names another file. Load time and the
+ * growth of the resident set it caused are kept for display.
+ *
+ * The library is never closed: libtorch registers global state that cannot be unloaded
+ * safely. Destroying the InferencePlugin destroys the engine (and joins its worker) only.
+ */
+class InferencePlugin
+{
+  public:
+    explicit InferencePlugin(std::size_t capacity = 4);
+    ~InferencePlugin();
+
+    InferencePlugin(const InferencePlugin&)            = delete;
+    InferencePlugin& operator=(const InferencePlugin&) = delete;
+
+    // Start loading; later calls do nothing
+    void load();
+
+    // The engine once the plugin is loaded, else nullptr (also after a failed load)
+    InferenceEngine* engine();
+
+    bool requested() const
+    {
+        return requested_;
+    }
+    bool failed() const
+    {
+        return failed_;
+    }
+
+    // Measured by the load: wall time and resident set growth
+    double loadMs() const
+    {
+        return load_ms_;
+    }
+    std::size_t rssDeltaBytes() const
+    {
+        return rss_delta_;
+    }
+
+    // Resident set size of this process in bytes (0 if unknown)
+    static std::size_t residentBytes();
+
+  private:
+    struct Loaded
+    {
+        std::unique_ptr<InferenceEngine> engine;
+        double                           ms        = 0.0;
+        std::size_t                      rss_delta = 0;
+    };
+
+    static Loaded open(std::size_t capacity);
+
+    std::size_t                      capacity_;
+    bool                             requested_ = false;
+    bool                             failed_    = false;
+    double                           load_ms_   = 0.0;
+    std::size_t                      rss_delta_ = 0;
+    std::future<Loaded>              pending_;
+    std::unique_ptr<InferenceEngine> engine_;
+};
+
+#endif // INFERENCE_PLUGIN_H
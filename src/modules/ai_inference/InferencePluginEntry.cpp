@@ -0,0 +1,33 @@
+// Entry points of the lucy_inference plugin (see InferenceEngine.h and InferencePlugin)
+#include "InferenceEngine.h"
+#include "InferenceService.h"
+
+#include <exception>
+#include <iostream>
+
+extern "C"
+{
+    int lucy_inference_abi_version()
+    {
+        return kInferenceAbiVersion;
+    }
+
+    // No exception may cross the C boundary: failures (no memory, no worker thread) become
+    // nullptr, which InferencePlugin reports as a failed load
+    InferenceEngine* lucy_inference_create(std::size_t capacity)
+    {
+        try
+        {
+            return new InferenceService(capacity);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Inference plugin: " << e.what() << '\n';
+        }
+        catch (...)
+        {
+            std::cerr << "Inference plugin: unknown error while creating the engine\n";
+        }
+        return nullptr;
+    }
+}
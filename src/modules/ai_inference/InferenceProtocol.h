@@ -0,0 +1,133 @@
+#ifndef INFERENCE_PROTOCOL_H
+#define INFERENCE_PROTOCOL_H
+
+// Wire format of the local inference server (pinn_server) over a Unix domain socket.
+// Native endianness: client and server always run on the same machine.
+//
+//   request:  RequestHeader, model name (name_size bytes), float32 inputs[count]
+//   response: ResponseHeader, float32 col1[count], float32 col2[count] (only if status == Ok)
+//
+// A connection may carry any number of request/response pairs, one at a time.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace InferenceProtocol
+{
+constexpr std::uint32_t kRequestMagic  = 0x51'4E'49'50; // "PINQ"
+constexpr std::uint32_t kResponseMagic = 0x52'4E'49'50; // "PINR"
+constexpr std::uint32_t kMaxNameSize   = 256;
+constexpr std::uint32_t kMaxCount      = 1u << 26; // 256 MiB of inputs per request
+
+enum class Status : std::uint32_t
+{
+    Ok           = 0,
+    UnknownModel = 1,
+    BadRequest   = 2,
+    Failed       = 3, // the model could not evaluate the inputs
+};
+
+struct RequestHeader
+{
+    std::uint32_t magic     = kRequestMagic;
+    std::uint32_t name_size = 0;
+    std::uint32_t count     = 0;
+};
+
+struct ResponseHeader
+{
+    std::uint32_t magic  = kResponseMagic;
+    Status        status = Status::Ok;
+    std::uint32_t count  = 0;
+};
+
+// Blocking full-length transfers; false on error or end of stream
+inline bool readAll(int fd, void* data, std::size_t size)
+{
+    auto* bytes = static_cast<char*>(data);
+    while (size > 0)
+    {
+        const ssize_t n = ::read(fd, bytes, size);
+        if (n <= 0)
+            return false;
+        bytes += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+inline bool writeAll(int fd, const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        const ssize_t n = ::send(fd, bytes, size, MSG_NOSIGNAL);
+        if (n <= 0)
+            return false;
+        bytes += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+inline bool fillAddress(const std::string& path, sockaddr_un& addr)
+{
+    addr            = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        return false;
+    path.copy(addr.sun_path, path.size());
+    return true;
+}
+
+// Client side: evaluate `inputs` with the server's model `model`. Returns the server status,
+// or Status::Failed if the server cannot be reached.
+inline Status evaluate(
+    const std::string&        socketPath,
+    const std::string&        model,
+    const std::vector<float>& inputs,
+    std::vector<float>&       col1,
+    std::vector<float>&       col2)
+{
+    sockaddr_un addr;
+    if (!fillAddress(socketPath, addr) || model.size() > kMaxNameSize || inputs.size() > kMaxCount)
+        return Status::BadRequest;
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return Status::Failed;
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        ::close(fd);
+        return Status::Failed;
+    }
+
+    RequestHeader request;
+    request.name_size = static_cast<std::uint32_t>(model.size());
+    request.count     = static_cast<std::uint32_t>(inputs.size());
+
+    ResponseHeader response;
+    bool           ok = writeAll(fd, &request, sizeof(request))
+              && writeAll(fd, model.data(), model.size())
+              && writeAll(fd, inputs.data(), inputs.size() * sizeof(float))
+              && readAll(fd, &response, sizeof(response)) && response.magic == kResponseMagic;
+    if (ok && response.status == Status::Ok)
+    {
+        col1.resize(response.count);
+        col2.resize(response.count);
+        ok = readAll(fd, col1.data(), col1.size() * sizeof(float))
+             && readAll(fd, col2.data(), col2.size() * sizeof(float));
+    }
+    ::close(fd);
+
+    return ok ? response.status : Status::Failed;
+}
+} // namespace InferenceProtocol
+
+#endif // INFERENCE_PROTOCOL_H
@@ -0,0 +1,204 @@
+#include "InferenceService.h"
+#include "ModelProcessor.h"
+
+#include <chrono>
+#include <iostream>
+
+InferenceService::InferenceService(std::size_t capacity)
+    : ring_(capacity + 1) // one slot stays free to tell "full" from "empty"
+    , capacity_(capacity)
+{
+    worker_ = std::thread(&InferenceService::workerLoop, this);
+}
+
+InferenceService::~InferenceService()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto& job : queue_)
+            job.cancelled = true;
+    }
+    cancel_running_ = true;
+    cv_.notify_all();
+    if (worker_.joinable())
+        worker_.join();
+}
+
+std::optional<InferenceService::Ticket>
+InferenceService::submit(InferenceRequest request, Callback on_done)
+{
+    // Reserve an in-flight slot (keeps the delivery ring from overflowing)
+    std::size_t in_flight = in_flight_.load();
+    do
+    {
+        if (in_flight >= capacity_)
+            return std::nullopt;
+    } while (!in_flight_.compare_exchange_weak(in_flight, in_flight + 1));
+
+    Job job;
+    job.id      = next_id_++;
+    job.request = std::move(request);
+    job.on_done = std::move(on_done);
+
+    Ticket ticket;
+    ticket.id     = job.id;
+    ticket.result = job.promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+    return ticket;
+}
+
+bool InferenceService::cancel(std::uint64_t id)
+{
+    // The worker moves jobs from the queue to running_id_ under the same lock
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& job : queue_)
+    {
+        if (job.id == id)
+        {
+            job.cancelled = true; // the worker completes it without running
+            return true;
+        }
+    }
+    if (id != 0 && running_id_.load() == id)
+    {
+        cancel_running_ = true;
+        return true;
+    }
+    return false;
+}
+
+void InferenceService::deliver()
+{
+    std::size_t head = ring_head_.load(std::memory_order_relaxed);
+    while (head != ring_tail_.load(std::memory_order_acquire))
+    {
+        Delivery delivery = std::move(ring_[head]);
+        ring_[head]       = {};
+        head              = (head + 1) % ring_.size();
+        ring_head_.store(head, std::memory_order_release);
+        --in_flight_;
+
+        if (delivery.on_done)
+            delivery.on_done(*delivery.result);
+    }
+}
+
+float InferenceService::progress() const
+{
+    return progress_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t InferenceService::runningId() const
+{
+    return running_id_.load(std::memory_order_relaxed);
+}
+
+void InferenceService::workerLoop()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+                return; // stopping and drained
+
+            job = std::move(queue_.front());
+            queue_.pop_front();
+            if (!job.cancelled)
+            {
+                cancel_running_ = false;
+                progress_       = 0.f;
+                running_id_     = job.id;
+            }
+        }
+
+        if (job.cancelled)
+        {
+            auto result       = std::make_shared<InferenceResult>();
+            result->id        = job.id;
+            result->cancelled = true;
+            finish(job, std::move(result));
+            continue;
+        }
+
+        finish(job, runJob(job));
+        running_id_ = 0;
+    }
+}
+
+InferenceService::ResultPtr InferenceService::runJob(const Job& job)
+{
+    const auto start  = std::chrono::steady_clock::now();
+    auto       result = std::make_shared<InferenceResult>();
+    result->id        = job.id;
+
+    const InferenceRequest& request = job.request;
+    ModelProcessor          processor(request.model_path, request.num_steps);
+    processor.setCacheDir(request.cache_dir);
+    processor.setOptimization(request.optimization);
+
+    const bool streaming = !request.output_path.empty();
+    if (!streaming && processor.loadCached())
+    {
+        // Cache hit: libtorch is never initialised for this request
+        progress_  = 1.f;
+        result->ok = true;
+    }
+    else if (processor.loadModel())
+    {
+        const auto on_chunk = [this](int done, int total)
+        {
+            progress_ = static_cast<float>(done) / static_cast<float>(total);
+            return !cancel_running_.load();
+        };
+
+        bool ok = false;
+        if (!streaming && request.adaptive)
+            ok = processor.inferAdaptive(request.adaptive_options, on_chunk);
+        else if (!streaming)
+            ok = processor.infer(request.chunk_size, on_chunk);
+        else
+            ok = processor.stream(
+                request.output_path,
+                request.binary_output ? ModelProcessor::StreamFormat::Binary
+                                      : ModelProcessor::StreamFormat::CSV,
+                request.chunk_size,
+                on_chunk);
+
+        result->cancelled = cancel_running_.load();
+        result->ok        = ok && !result->cancelled;
+        if (result->ok && !streaming)
+            processor.storeCached();
+    }
+
+    if (result->ok)
+    {
+        result->inputs      = processor.inputs();
+        result->output_col1 = processor.outputCol1();
+        result->output_col2 = processor.outputCol2();
+        result->y_min       = processor.yMin();
+        result->y_max       = processor.yMax();
+    }
+
+    result->ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    return result;
+}
+
+void InferenceService::finish(Job& job, ResultPtr result)
+{
+    job.promise.set_value(result);
+
+    // Single producer: only this worker writes the tail
+    const std::size_t tail = ring_tail_.load(std::memory_order_relaxed);
+    ring_[tail]            = {std::move(result), std::move(job.on_done)};
+    ring_tail_.store((tail + 1) % ring_.size(), std::memory_order_release);
+}
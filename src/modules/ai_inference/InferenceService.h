@@ -0,0 +1,90 @@
+#ifndef INFERENCE_SERVICE_H
+#define INFERENCE_SERVICE_H
+
+#include "InferenceEngine.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs ModelProcessor jobs on one dedicated worker thread.
+ *
+ * Requests wait in a bounded queue; submit() refuses new work while `capacity` requests are
+ * queued, running or not yet delivered. Each request yields a future and/or a callback. Callbacks
+ * run on the UI thread inside deliver(), which pops finished results from a single-producer /
+ * single-consumer ring without taking a lock, so it is safe to call every frame. Progress and
+ * cancellation work at chunk granularity.
+ */
+class InferenceService : public InferenceEngine
+{
+  public:
+    explicit InferenceService(std::size_t capacity = 4);
+    ~InferenceService() override; // cancels queued and running work, joins the worker
+
+    InferenceService(const InferenceService&)            = delete;
+    InferenceService& operator=(const InferenceService&) = delete;
+
+    // Queue a request; std::nullopt if the service is at capacity
+    std::optional<Ticket> submit(InferenceRequest request, Callback on_done = {}) override;
+
+    // Cancel a queued request, or stop the running one after its current chunk
+    bool cancel(std::uint64_t id) override;
+
+    // UI thread: run the callbacks of finished requests. Lock-free.
+    void deliver() override;
+
+    // Progress of the running request (0..1) and its id (0 = idle). Lock-free.
+    float         progress() const override;
+    std::uint64_t runningId() const override;
+
+  private:
+    struct Job
+    {
+        std::uint64_t           id = 0;
+        InferenceRequest        request;
+        Callback                on_done;
+        std::promise<ResultPtr> promise;
+        bool                    cancelled = false; // finished unrun by the worker
+    };
+
+    struct Delivery
+    {
+        ResultPtr result;
+        Callback  on_done;
+    };
+
+    void      workerLoop();
+    ResultPtr runJob(const Job& job);
+    void      finish(Job& job, ResultPtr result); // promise + ring; worker thread only
+
+    // Worker → UI ring (single producer: finish(), single consumer: deliver()).
+    // Sized so it can never overflow: submit() keeps in-flight work below capacity.
+    std::vector<Delivery>    ring_;
+    std::atomic<std::size_t> ring_head_{0}; // next slot to read (consumer)
+    std::atomic<std::size_t> ring_tail_{0}; // next slot to write (producer)
+
+    std::size_t                capacity_;
+    std::atomic<std::size_t>   in_flight_{0}; // submitted, not yet delivered
+    std::atomic<std::uint64_t> next_id_{1};
+    std::atomic<std::uint64_t> running_id_{0};
+    std::atomic<float>         progress_{0.f};
+    std::atomic<bool>          cancel_running_{false};
+
+    std::mutex              mutex_; // guards queue_ and stopping_ (never taken by deliver())
+    std::condition_variable cv_;
+    std::deque<Job>         queue_;
+    bool                    stopping_ = false;
+    std::thread             worker_;
+};
+
+#endif // INFERENCE_SERVICE_H
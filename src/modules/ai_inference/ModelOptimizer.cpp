@@ -0,0 +1,229 @@
+#include "ModelOptimizer.h"
+
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <torch/csrc/jit/passes/inliner.h>
+
+#include <iostream>
+#include <string>
+
+namespace ModelOptimizer
+{
+namespace
+{
+constexpr int64_t kMinInt8Inputs = 8;
+
+// Boxed call into a registered operator; returns its first output
+c10::IValue callOp(const char* name, torch::jit::Stack stack)
+{
+    const auto op = c10::Dispatcher::singleton().findSchemaOrThrow(name, "");
+    op.callBoxed(&stack);
+    return stack.front();
+}
+
+// Element-wise activations of aten that NativeMlp::Activation has no counterpart for
+bool isUnsupportedActivation(const std::string& op)
+{
+    static const char* const kOps[] = {
+        "gelu",
+        "elu",
+        "selu",
+        "celu",
+        "silu",
+        "mish",
+        "softplus",
+        "softsign",
+        "leaky_relu",
+        "prelu",
+        "rrelu",
+        "relu6",
+        "hardtanh",
+        "hardsigmoid",
+        "hardswish",
+        "logsigmoid",
+        "tanhshrink",
+    };
+    for (const char* name : kOps)
+    {
+        if (op == name)
+            return true;
+    }
+    return false;
+}
+
+at::Tensor activate(const at::Tensor& x, NativeMlp::Activation activation)
+{
+    switch (activation)
+    {
+    case NativeMlp::Activation::Tanh:
+        return at::tanh(x);
+    case NativeMlp::Activation::Relu:
+        return at::relu(x);
+    case NativeMlp::Activation::Sigmoid:
+        return at::sigmoid(x);
+    case NativeMlp::Activation::Identity:
+        break;
+    }
+    return x;
+}
+} // namespace
+
+torch::jit::Module freezeForInference(torch::jit::Module module)
+{
+    module.eval();
+    torch::jit::Module frozen = torch::jit::freeze(module);
+    return torch::jit::optimize_for_inference(frozen);
+}
+
+std::size_t weightBytes(const torch::jit::Module& module)
+{
+    std::size_t bytes = 0;
+    for (const auto& p : module.parameters())
+        bytes += p.numel() * p.element_size();
+    for (const auto& b : module.buffers())
+        bytes += b.numel() * b.element_size();
+    return bytes;
+}
+
+std::vector<DenseLayer> denseLayers(const torch::jit::Module& module)
+{
+    std::vector<at::Tensor> tensors;
+    for (const auto& b : module.buffers())
+        tensors.push_back(b.detach().to(torch::kFloat32).contiguous());
+
+    if (tensors.empty() || tensors.size() % 2 != 0)
+    {
+        std::cerr << "Dense layers: expected (weight, bias) buffer pairs, found " << tensors.size()
+                  << " buffers\n";
+        return {};
+    }
+
+    std::vector<DenseLayer> layers;
+    int64_t                 features = 1; // the model input is one scalar per step
+    for (std::size_t i = 0; i < tensors.size(); i += 2)
+    {
+        const at::Tensor& w = tensors[i];     // [in, out]
+        const at::Tensor& b = tensors[i + 1]; // [out]
+        if (w.dim() != 2 || b.dim() != 1 || w.size(0) != features || w.size(1) != b.size(0))
+        {
+            std::cerr << "Dense layers: layer " << i / 2
+                      << " is not a dense layer of the expected shape\n";
+            return {};
+        }
+        features = w.size(1);
+        layers.push_back({w, b});
+    }
+    return layers;
+}
+
+bool graphActivations(
+    const torch::jit::Module&           module,
+    std::vector<NativeMlp::Activation>& activations)
+{
+    auto graph = module.get_method("forward").graph()->copy();
+    torch::jit::Inline(*graph);
+
+    activations.clear();
+    for (const torch::jit::Node* node : graph->nodes())
+    {
+        if (!node->kind().is_aten())
+            continue;
+
+        // In-place variants (aten::tanh_) compute the same thing
+        std::string op = node->kind().toUnqualString();
+        if (!op.empty() && op.back() == '_')
+            op.pop_back();
+
+        if (op == "tanh")
+            activations.push_back(NativeMlp::Activation::Tanh);
+        else if (op == "relu")
+            activations.push_back(NativeMlp::Activation::Relu);
+        else if (op == "sigmoid")
+            activations.push_back(NativeMlp::Activation::Sigmoid);
+        else if (isUnsupportedActivation(op))
+        {
+            std::cerr << "Activations: aten::" << op << " is not supported\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool layerActivations(
+    const torch::jit::Module&           module,
+    std::size_t                         layerCount,
+    std::vector<NativeMlp::Activation>& activations)
+{
+    if (!graphActivations(module, activations))
+        return false;
+
+    // A plain MLP has one activation between consecutive layers and none after the last
+    if (layerCount == 0 || activations.size() != layerCount - 1)
+    {
+        std::cerr << "Activations: found " << activations.size() << " activations for "
+                  << layerCount << " dense layers\n";
+        return false;
+    }
+    activations.push_back(NativeMlp::Activation::Identity);
+    return true;
+}
+
+std::shared_ptr<const QuantizedMlp> QuantizedMlp::fromModule(const torch::jit::Module& module)
+{
+    const std::vector<DenseLayer> dense = denseLayers(module);
+    if (dense.empty())
+        return nullptr;
+
+    std::vector<NativeMlp::Activation> activations;
+    if (!layerActivations(module, dense.size(), activations))
+        return nullptr;
+
+    auto mlp = std::make_shared<QuantizedMlp>();
+    // fbgemm (x86) wants 7-bit activations to avoid saturating its int16 accumulation
+    mlp->reduce_range_ = at::globalContext().qEngine() != at::QEngine::QNNPACK;
+
+    for (std::size_t i = 0; i < dense.size(); ++i)
+    {
+        const at::Tensor& w = dense[i].weight;
+        const at::Tensor& b = dense[i].bias;
+
+        Layer layer;
+        layer.bias       = b;
+        layer.activation = activations[i];
+        if (w.size(0) < kMinInt8Inputs)
+        {
+            layer.weight = w;
+            mlp->bytes_ += w.numel() * sizeof(float);
+        }
+        else
+        {
+            // Symmetric per-output-channel scales, as the dynamic quantisation default does
+            const at::Tensor wt = w.t().contiguous(); // [out, in] for quantized::linear
+            const at::Tensor scales =
+                (wt.abs().amax(1) / 127.0).clamp_min(1e-8).to(torch::kDouble);
+            const at::Tensor zeros = torch::zeros({wt.size(0)}, torch::kLong);
+            const at::Tensor q     = at::quantize_per_channel(wt, scales, zeros, 0, torch::kQInt8);
+
+            layer.packed = callOp("quantized::linear_prepack", {q, c10::optional<at::Tensor>(b)});
+            layer.int8   = true;
+            mlp->bytes_ += wt.numel() + scales.numel() * sizeof(double);
+        }
+        mlp->bytes_ += b.numel() * sizeof(float);
+        mlp->layers_.push_back(std::move(layer));
+    }
+    return mlp;
+}
+
+at::Tensor QuantizedMlp::forward(const at::Tensor& input) const
+{
+    at::Tensor x = input;
+    for (const Layer& layer : layers_)
+    {
+        if (layer.int8)
+            x = callOp("quantized::linear_dynamic", {x, layer.packed, reduce_range_}).toTensor();
+        else
+            x = at::addmm(layer.bias, x, layer.weight);
+        x = activate(x, layer.activation);
+    }
+    return x;
+}
+} // namespace ModelOptimizer
@@ -0,0 +1,83 @@
+#ifndef MODEL_OPTIMIZER_H
+#define MODEL_OPTIMIZER_H
+
+#include "NativeMlp.h"
+
+#include <torch/script.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Inference-only transformations of a loaded TorchScript model, used by ModelProcessor
+namespace ModelOptimizer
+{
+// eval() + torch::jit::freeze + torch::jit::optimize_for_inference. Throws c10::Error.
+torch::jit::Module freezeForInference(torch::jit::Module module);
+
+// Bytes held by the module's parameters and buffers (recursively)
+std::size_t weightBytes(const torch::jit::Module& module);
+
+struct DenseLayer
+{
+    at::Tensor weight; // float [in, out]
+    at::Tensor bias;   // float [out]
+};
+
+// The dense layers of an ONNX-converted MLP: its (weight, bias) buffer pairs in order, checked to
+// chain from one scalar input. Empty (with a message on std::cerr) for any other module.
+std::vector<DenseLayer> denseLayers(const torch::jit::Module& module);
+
+// Activations in the order they appear in the inlined forward graph. False (with a message on
+// std::cerr) if the graph uses an activation NativeMlp::Activation cannot express.
+bool graphActivations(
+    const torch::jit::Module&           module,
+    std::vector<NativeMlp::Activation>& activations);
+
+// One activation per dense layer: the graph's activations between the layers, Identity after
+// the last. False if the module is not such a plain MLP.
+bool layerActivations(
+    const torch::jit::Module&           module,
+    std::size_t                         layerCount,
+    std::vector<NativeMlp::Activation>& activations);
+
+/**
+ * Dense stack with int8 weights and dynamically quantised activations.
+ *
+ * The PINN is an ONNX conversion: its dense layers are MatMul + Add on buffers of the
+ * `initializers` submodule rather than nn.Linear modules, so quantize_dynamic-style module
+ * swapping has nothing to find. fromModule() takes the denseLayers() instead, quantises each
+ * weight per output channel and runs the layers through quantized::linear_dynamic, each followed
+ * by the activation the graph applies after it (layerActivations). Layers with very few inputs
+ * stay float: int8 saves nothing there and costs the most accuracy.
+ */
+class QuantizedMlp
+{
+  public:
+    // nullptr if the module is not a plain MLP of that shape with supported activations
+    static std::shared_ptr<const QuantizedMlp> fromModule(const torch::jit::Module& module);
+
+    at::Tensor forward(const at::Tensor& input) const;
+
+    std::size_t weightBytes() const
+    {
+        return bytes_;
+    }
+
+  private:
+    struct Layer
+    {
+        c10::IValue           packed; // quantized::linear_prepack result (int8 layers)
+        at::Tensor            weight; // float [in, out] (float layers)
+        at::Tensor            bias;
+        NativeMlp::Activation activation = NativeMlp::Activation::Identity;
+        bool                  int8       = false;
+    };
+
+    std::vector<Layer> layers_;
+    bool               reduce_range_ = false;
+    std::size_t        bytes_        = 0;
+};
+} // namespace ModelOptimizer
+
+#endif // MODEL_OPTIMIZER_H
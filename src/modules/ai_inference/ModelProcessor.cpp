@@ -1,117 +1,326 @@
 #include "ModelProcessor.h"
 
+#include "../../io/array_writer.h"
+#include "../../io/csv_writer.h"
+#include "InferenceCache.h"
+#include "SeriesDecimator.h"
+
+#include <algorithm>
+#include <chrono>
+
 ModelProcessor::ModelProcessor(const std::string& model_path, int num_steps)
     : model_path_(model_path)
     , num_steps_(num_steps)
     , y_min_(std::numeric_limits<float>::max())
     , y_max_(std::numeric_limits<float>::lowest())
 {
-    data_.resize(num_steps_);
-    for (int i = 0; i < num_steps_; ++i)
-    {
-        data_[i] = i * 0.001f;
-    }
+}
+
+float ModelProcessor::stepInput(int i)
+{
+    // Computed in double: i * 0.001f loses whole steps once the grid reaches ~10^7 points
+    return static_cast<float>(i * kStepSize);
 }
 
 bool ModelProcessor::loadModel()
 {
-    try
+    backend_ = InferenceBackend::load(model_path_, optimization_);
+    return backend_ != nullptr;
+}
+
+bool ModelProcessor::processChunk(const float* input, int count, float* col1, float* col2)
+{
+    if (!backend_)
     {
-        module_ = torch::jit::load(model_path_);
+        std::cerr << "No model loaded\n";
+        return false;
     }
-    catch (const c10::Error& e)
+    return backend_->forward(input, count, col1, col2, y_min_, y_max_);
+}
+
+bool ModelProcessor::infer(int chunk_size, const ChunkCallback& on_chunk)
+{
+    if (chunk_size <= 0 || chunk_size > num_steps_)
+        chunk_size = num_steps_;
+
+    data_.resize(num_steps_);
+    for (int i = 0; i < num_steps_; ++i)
+        data_[i] = stepInput(i);
+    output_col1_.resize(num_steps_);
+    output_col2_.resize(num_steps_);
+    y_min_ = std::numeric_limits<float>::max();
+    y_max_ = std::numeric_limits<float>::lowest();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int offset = 0; offset < num_steps_; offset += chunk_size)
     {
-        std::cerr << "Error loading the model: " << e.what() << "\n";
-        return false;
+        const int count = std::min(chunk_size, num_steps_ - offset);
+        if (!processChunk(
+                data_.data() + offset,
+                count,
+                output_col1_.data() + offset,
+                output_col2_.data() + offset))
+            return false;
+        if (on_chunk && !on_chunk(offset + count, num_steps_))
+            return false;
     }
+
+    const auto ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    std::cout << "Inference + post-processing of " << num_steps_ << " steps took " << ms
+              << " ms\n";
     return true;
 }
 
-void ModelProcessor::prepareInput()
+bool ModelProcessor::inferAdaptive(
+    const AdaptiveGrid::Options& options,
+    const ChunkCallback&         on_level)
 {
-    auto          options      = torch::TensorOptions().dtype(torch::kFloat32);
-    torch::Tensor input_tensor = torch::from_blob(data_.data(), {num_steps_, 1}, options).clone();
-    output_                    = module_.forward({input_tensor}).toTensor();
+    y_min_ = std::numeric_limits<float>::max();
+    y_max_ = std::numeric_limits<float>::lowest();
+
+    const auto         start = std::chrono::steady_clock::now();
+    AdaptiveGrid       grid(num_steps_, options);
+    std::vector<float> input, col1, col2;
+    int                evaluated = 0;
+    while (!grid.pending().empty())
+    {
+        const std::vector<int>& steps = grid.pending();
+        const int               count = static_cast<int>(steps.size());
+        input.resize(count);
+        col1.resize(count);
+        col2.resize(count);
+        for (int i = 0; i < count; ++i)
+            input[i] = stepInput(steps[i]);
+
+        if (!processChunk(input.data(), count, col1.data(), col2.data()))
+            return false;
+        evaluated += count;
+        grid.accept(col1.data(), col2.data());
+        if (on_level && !on_level(evaluated, num_steps_))
+            return false;
+    }
+
+    data_.resize(grid.steps().size());
+    for (std::size_t i = 0; i < data_.size(); ++i)
+        data_[i] = stepInput(grid.steps()[i]);
+    output_col1_ = grid.col1();
+    output_col2_ = grid.col2();
+
+    const auto ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    std::cout << "Adaptive inference evaluated " << evaluated << " of " << num_steps_
+              << " steps in " << grid.levels() << " passes, took " << ms << " ms\n";
+    return true;
 }
 
-bool ModelProcessor::process()
+bool ModelProcessor::stream(
+    const std::string&   filename,
+    StreamFormat         format,
+    int                  chunk_size,
+    const ChunkCallback& on_chunk)
 {
-    auto sizes = output_.sizes();
-    if (sizes.size() != 2 || sizes[0] != num_steps_)
+    if (chunk_size <= 0 || chunk_size > num_steps_)
+        chunk_size = num_steps_;
+
+    const bool    binary = format == StreamFormat::Binary;
+    CsvWriter     csv;
+    std::ofstream raw;
+    if (binary)
     {
-        std::cerr << "Unexpected output tensor shape\n";
-        return false;
+        raw.open(filename, std::ios::binary);
+        if (!raw.is_open())
+        {
+            std::cerr << "Failed to open file: " << filename << "\n";
+            return false;
+        }
     }
+    else if (!csv.open(filename))
+        return false;
 
-    output_col1_.resize(num_steps_);
-    output_col2_.resize(num_steps_);
+    // The only per-run allocations: one chunk of inputs, outputs and interleaved rows
+    data_.clear();
+    output_col1_.clear();
+    output_col2_.clear();
+    std::vector<float> input(chunk_size), col1(chunk_size), col2(chunk_size);
+    std::vector<float> rows(binary ? 2 * static_cast<std::size_t>(chunk_size) : 0);
+    y_min_ = std::numeric_limits<float>::max();
+    y_max_ = std::numeric_limits<float>::lowest();
 
-    for (int64_t i = 0; i < sizes[0]; ++i)
+    const auto start = std::chrono::steady_clock::now();
+    for (int offset = 0; offset < num_steps_; offset += chunk_size)
+    {
+        const int count = std::min(chunk_size, num_steps_ - offset);
+        for (int i = 0; i < count; ++i)
+            input[i] = stepInput(offset + i);
+
+        if (!processChunk(input.data(), count, col1.data(), col2.data()))
+            return false;
+
+        if (binary)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                rows[2 * i]     = col1[i];
+                rows[2 * i + 1] = col2[i];
+            }
+            raw.write(
+                reinterpret_cast<const char*>(rows.data()),
+                static_cast<std::streamsize>(2 * count * sizeof(float)));
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i)
+                csv.row(col1[i], col2[i]);
+        }
+
+        if (binary && !raw)
+        {
+            std::cerr << "Failed to write to " << filename << "\n";
+            return false;
+        }
+        if (on_chunk && !on_chunk(offset + count, num_steps_))
+            return false;
+    }
+    if (!binary && !csv.close())
     {
-        float val1      = output_[i][0].item<float>();
-        float val2      = output_[i][1].item<float>();
-        output_col1_[i] = val1;
-        output_col2_[i] = val2;
-        y_min_          = std::min({y_min_, val1, val2});
-        y_max_          = std::max({y_max_, val1, val2});
+        std::cerr << "Failed to write to " << filename << "\n";
+        return false;
     }
 
+    const auto ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    std::cout << "Streamed " << num_steps_ << " steps to " << filename << " in " << ms
+              << " ms (chunk " << chunk_size << ")\n";
     return true;
 }
 
+bool ModelProcessor::evaluate(const float* input, int count, float* col1, float* col2)
+{
+    if (count <= 0)
+        return count == 0;
+    return processChunk(input, count, col1, col2);
+}
+
 bool ModelProcessor::run()
 {
-    return loadModel() && (prepareInput(), process());
+    if (loadCached())
+        return true;
+    if (!loadModel() || !infer())
+        return false;
+    storeCached(); // a failed write only costs the next launch another evaluation
+    return true;
 }
 
-bool ModelProcessor::saveCSV(const std::string& filename) const
+bool ModelProcessor::loadCached()
 {
-    std::ofstream outfile(filename);
-    if (!outfile.is_open())
-    {
-        std::cerr << "Failed to open file: " << filename << "\n";
+    if (cache_dir_.empty())
+        return false;
+
+    const std::uint64_t key = InferenceCache::makeKey(
+        model_path_, num_steps_, kStepSize, static_cast<std::uint32_t>(optimization_));
+    InferenceCache::Entry entry;
+    if (key == 0 || !InferenceCache::load(cache_dir_, key, entry)
+        || entry.output_col1.size() != static_cast<std::size_t>(num_steps_))
         return false;
-    }
 
+    data_.resize(num_steps_);
     for (int i = 0; i < num_steps_; ++i)
+        data_[i] = stepInput(i);
+    output_col1_ = std::move(entry.output_col1);
+    output_col2_ = std::move(entry.output_col2);
+    y_min_       = entry.y_min;
+    y_max_       = entry.y_max;
+    std::cout << "Loaded " << num_steps_ << " cached inference results\n";
+    return true;
+}
+
+bool ModelProcessor::storeCached() const
+{
+    if (cache_dir_.empty() || output_col1_.size() != static_cast<std::size_t>(num_steps_))
+        return false;
+
+    const std::uint64_t key = InferenceCache::makeKey(
+        model_path_, num_steps_, kStepSize, static_cast<std::uint32_t>(optimization_));
+    return key != 0
+           && InferenceCache::store(cache_dir_, key, output_col1_, output_col2_, y_min_, y_max_);
+}
+
+bool ModelProcessor::saveCSV(const std::string& filename) const
+{
+    CsvWriter csv;
+    if (!csv.open(filename))
+        return false;
+
+    // Empty after stream(), which has already written its rows
+    for (std::size_t i = 0; i < output_col1_.size(); ++i)
+        csv.row(output_col1_[i], output_col2_[i]);
+
+    if (!csv.close())
     {
-        outfile << output_col1_[i] << "," << output_col2_[i] << "\n";
+        std::cerr << "Failed to write to " << filename << "\n";
+        return false;
     }
-
-    outfile.close();
     return true;
 }
 
+bool ModelProcessor::saveNpy(const std::string& filename) const
+{
+    return ArrayWriter::writeNpy(
+        filename, {output_col1_.data(), output_col2_.data()}, output_col1_.size());
+}
+
+bool ModelProcessor::saveBinary(const std::string& filename) const
+{
+    return ArrayWriter::writeRawFloat32(
+        filename, {output_col1_.data(), output_col2_.data()}, output_col1_.size());
+}
+
 bool ModelProcessor::plotOutput(const std::string& filename) const
 {
     const int width  = 1024;
     const int height = 768;
     cv::Mat   plot(height, width, CV_8UC3, cv::Scalar(255, 255, 255));
 
+    const std::size_t count = std::min(data_.size(), output_col1_.size());
+    if (count == 0)
+    {
+        std::cerr << "Nothing to plot: run inference first\n";
+        return false;
+    }
+
+    // The grid is sorted, so its ends give the x range
+    const float x_min   = data_.front();
+    const float x_max   = data_[count - 1];
+    const float x_scale = x_max > x_min ? (width - 1) / (x_max - x_min) : 0.f;
+    const float y_range = y_max_ > y_min_ ? y_max_ - y_min_ : 1.f;
+
     auto map_x = [=](float x)
     {
-        return static_cast<int>((x / 40.0f) * width);
+        return static_cast<int>((x - x_min) * x_scale);
     };
     auto map_y = [=](float y)
     {
-        return static_cast<int>(height - ((y - y_min_) / (y_max_ - y_min_)) * height);
+        return static_cast<int>(height - ((y - y_min_) / y_range) * height);
     };
 
-    for (int i = 1; i < num_steps_; ++i)
+    // At most four points per pixel column per series; draws the same pixels as every segment
+    std::vector<SeriesDecimator::Point> decimated;
+    std::vector<cv::Point>              polyline;
+
+    auto drawSeries = [&](const std::vector<float>& y, const cv::Scalar& color)
     {
-        cv::line(
-            plot,
-            cv::Point(map_x(data_[i - 1]), map_y(output_col1_[i - 1])),
-            cv::Point(map_x(data_[i]), map_y(output_col1_[i])),
-            cv::Scalar(0, 0, 255),
-            1);
-        cv::line(
-            plot,
-            cv::Point(map_x(data_[i - 1]), map_y(output_col2_[i - 1])),
-            cv::Point(map_x(data_[i]), map_y(output_col2_[i])),
-            cv::Scalar(255, 0, 0),
-            1);
-    }
+        SeriesDecimator::decimate(data_.data(), y.data(), count, x_min, x_max, width, decimated);
+        polyline.clear();
+        for (const auto& p : decimated)
+            polyline.emplace_back(map_x(p.x), map_y(p.y));
+        cv::polylines(plot, polyline, false, color, 1);
+    };
+    drawSeries(output_col1_, cv::Scalar(0, 0, 255));
+    drawSeries(output_col2_, cv::Scalar(255, 0, 0));
 
     // Gridlines
     int grid_spacing_x = 100;
@@ -1,36 +1,137 @@
 #ifndef MODEL_PROCESSOR_H
 #define MODEL_PROCESSOR_H
 
+#include "AdaptiveGrid.h"
+#include "InferenceBackend.h"
+
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <opencv2/opencv.hpp>
 #include <string>
-#include <torch/script.h>
 #include <vector>
 
 class ModelProcessor
 {
   public:
     ModelProcessor(const std::string& model_path, int num_steps = 40000);
-    bool run();
+    bool run(); // cached result, or loadModel() + infer() + storeCached()
+    bool loadModel();
+
+    using Optimization = InferenceBackend::Optimization;
+
+    // Applied by the next loadModel() to TorchScript models; see pinn_optimize for the accuracy /
+    // speed trade-off
+    void setOptimization(Optimization optimization)
+    {
+        optimization_ = optimization;
+    }
+
+    // Weight memory of the loaded model (after optimisation)
+    std::size_t weightBytes() const
+    {
+        return backend_ ? backend_->weightBytes() : 0;
+    }
+
+    // "native", "torch" or "torch-int8" once a model is loaded
+    const char* backendName() const
+    {
+        return backend_ ? backend_->name() : "none";
+    }
+
+    // Result cache (InferenceCache) keyed by model bytes, grid and libtorch version.
+    // loadCached() restores inputs, outputs and min/max without touching TorchScript;
+    // storeCached() saves the result of the last infer(). An empty directory disables both.
+    void setCacheDir(const std::string& cache_dir)
+    {
+        cache_dir_ = cache_dir;
+    }
+    bool loadCached();
+    bool storeCached() const;
+
+    // Called after every chunk with (steps done, total steps); return false to cancel
+    using ChunkCallback = std::function<bool(int, int)>;
+
+    // Evaluate the grid in chunks of `chunk_size` steps (0 = one forward pass).
+    // Returns false on error or when `on_chunk` cancelled.
+    bool infer(int chunk_size = 0, const ChunkCallback& on_chunk = {});
+
+    // Evaluate only the grid steps AdaptiveGrid selects: a coarse level first, then one forward
+    // pass per refinement level over the intervals that still bend or jump. inputs() holds the
+    // chosen (non-uniform) x values. `on_level` gets (steps evaluated so far, grid size).
+    // The result is not a full grid, so storeCached() ignores it.
+    bool inferAdaptive(
+        const AdaptiveGrid::Options& options  = {},
+        const ChunkCallback&         on_level = {});
+
+    enum class StreamFormat
+    {
+        CSV,   // "col1,col2" per line, same as saveCSV()
+        Binary // raw native-endian float32 pairs (col1, col2), one per step
+    };
+
+    // Evaluate the grid chunk by chunk and write each chunk to `filename` as soon as it is
+    // produced. Nothing is kept in memory beyond one chunk (inputs() and the output columns stay
+    // empty), so the step count is bounded by disk space only; yMin() / yMax() are still updated.
+    bool stream(
+        const std::string&   filename,
+        StreamFormat         format,
+        int                  chunk_size = 65536,
+        const ChunkCallback& on_chunk   = {});
+
+    // One forward pass over arbitrary inputs, independent of the built-in grid (used by the
+    // inference server). Writes `count` values to each of col1 / col2 and updates the min/max.
+    bool evaluate(const float* input, int count, float* col1, float* col2);
+
+    // "col1,col2" per step (CsvWriter)
     bool saveCSV(const std::string& filename) const;
+    // Both output columns as a (steps, 2) float32 .npy, or raw float32 col1 then col2
+    bool saveNpy(const std::string& filename) const;
+    bool saveBinary(const std::string& filename) const;
     bool plotOutput(const std::string& filename) const;
 
+    const std::vector<float>& inputs() const
+    {
+        return data_;
+    }
+    const std::vector<float>& outputCol1() const
+    {
+        return output_col1_;
+    }
+    const std::vector<float>& outputCol2() const
+    {
+        return output_col2_;
+    }
+    float yMin() const
+    {
+        return y_min_;
+    }
+    float yMax() const
+    {
+        return y_max_;
+    }
+
   private:
-    std::string                model_path_;
-    int                        num_steps_;
-    std::vector<float>         data_;
-    std::vector<float>         output_col1_;
-    std::vector<float>         output_col2_;
-    float                      y_min_;
-    float                      y_max_;
-    torch::jit::script::Module module_;
-    at::Tensor                 output_;
+    std::string        model_path_;
+    std::string        cache_dir_ = ".cache/ai_inference";
+    int                num_steps_;
+    std::vector<float> data_;
+    std::vector<float> output_col1_;
+    std::vector<float> output_col2_;
+    float              y_min_;
+    float              y_max_;
+    Optimization       optimization_ = Optimization::None;
 
-    bool loadModel();
-    void prepareInput();
-    bool process();
+    std::unique_ptr<InferenceBackend> backend_; // InferenceBackend::load() in loadModel()
+
+    // Model input of grid step i
+    static constexpr double kStepSize = 0.001;
+    static float            stepInput(int i);
+
+    // Forward `count` inputs, split the outputs into col1 / col2 and update the min/max
+    bool processChunk(const float* input, int count, float* col1, float* col2);
 };
 
 #endif // MODEL_PROCESSOR_H
@@ -0,0 +1,502 @@
+#include "NativeMlp.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+constexpr char          kMagic[4]  = {'P', 'M', 'L', 'P'};
+constexpr std::uint32_t kVersion   = 1;
+constexpr std::uint32_t kMaxLayers = 1024;    // sanity limits for corrupt files
+constexpr int           kMaxWidth  = 1 << 16;
+constexpr int           kTileRows  = 32;      // rows per tile: two activation buffers fit L1
+
+struct FileHeader
+{
+    char          magic[4];
+    std::uint32_t version;
+    std::uint32_t layers;
+    std::uint32_t reserved;
+};
+
+struct LayerHeader
+{
+    std::uint32_t inputs;
+    std::uint32_t outputs;
+    std::uint32_t activation;
+    std::uint32_t reserved;
+};
+
+// ── SIMD primitives: one register of kLanes floats ─────────
+#if defined(__ARM_NEON) && defined(__aarch64__)
+using Vec               = float32x4_t;
+constexpr int kLanes    = 4;
+constexpr int kRowBlock = 4; // 16 accumulators of 32 registers
+
+inline Vec load(const float* p)
+{
+    return vld1q_f32(p);
+}
+inline void store(float* p, Vec v)
+{
+    vst1q_f32(p, v);
+}
+inline Vec splat(float x)
+{
+    return vdupq_n_f32(x);
+}
+inline Vec fmadd(Vec a, Vec b, Vec c) // a * b + c
+{
+    return vfmaq_f32(c, a, b);
+}
+inline Vec mul(Vec a, Vec b)
+{
+    return vmulq_f32(a, b);
+}
+inline Vec div(Vec a, Vec b)
+{
+    return vdivq_f32(a, b);
+}
+inline Vec min(Vec a, Vec b)
+{
+    return vminq_f32(a, b);
+}
+inline Vec max(Vec a, Vec b)
+{
+    return vmaxq_f32(a, b);
+}
+#elif defined(__AVX2__) && defined(__FMA__)
+using Vec               = __m256;
+constexpr int kLanes    = 8;
+constexpr int kRowBlock = 2; // 8 accumulators of 16 registers
+
+inline Vec load(const float* p)
+{
+    return _mm256_loadu_ps(p);
+}
+inline void store(float* p, Vec v)
+{
+    _mm256_storeu_ps(p, v);
+}
+inline Vec splat(float x)
+{
+    return _mm256_set1_ps(x);
+}
+inline Vec fmadd(Vec a, Vec b, Vec c)
+{
+    return _mm256_fmadd_ps(a, b, c);
+}
+inline Vec mul(Vec a, Vec b)
+{
+    return _mm256_mul_ps(a, b);
+}
+inline Vec div(Vec a, Vec b)
+{
+    return _mm256_div_ps(a, b);
+}
+inline Vec min(Vec a, Vec b)
+{
+    return _mm256_min_ps(a, b);
+}
+inline Vec max(Vec a, Vec b)
+{
+    return _mm256_max_ps(a, b);
+}
+#elif defined(__SSE2__)
+using Vec               = __m128;
+constexpr int kLanes    = 4;
+constexpr int kRowBlock = 2;
+
+inline Vec load(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void store(float* p, Vec v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline Vec splat(float x)
+{
+    return _mm_set1_ps(x);
+}
+inline Vec fmadd(Vec a, Vec b, Vec c)
+{
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+inline Vec mul(Vec a, Vec b)
+{
+    return _mm_mul_ps(a, b);
+}
+inline Vec div(Vec a, Vec b)
+{
+    return _mm_div_ps(a, b);
+}
+inline Vec min(Vec a, Vec b)
+{
+    return _mm_min_ps(a, b);
+}
+inline Vec max(Vec a, Vec b)
+{
+    return _mm_max_ps(a, b);
+}
+#else
+using Vec               = float;
+constexpr int kLanes    = 1;
+constexpr int kRowBlock = 4;
+
+inline Vec load(const float* p)
+{
+    return *p;
+}
+inline void store(float* p, Vec v)
+{
+    *p = v;
+}
+inline Vec splat(float x)
+{
+    return x;
+}
+inline Vec fmadd(Vec a, Vec b, Vec c)
+{
+    return a * b + c;
+}
+inline Vec mul(Vec a, Vec b)
+{
+    return a * b;
+}
+inline Vec div(Vec a, Vec b)
+{
+    return a / b;
+}
+inline Vec min(Vec a, Vec b)
+{
+    return a < b ? a : b;
+}
+inline Vec max(Vec a, Vec b)
+{
+    return a > b ? a : b;
+}
+#endif
+
+constexpr int kColBlock = 4 * kLanes; // output columns per micro-kernel call
+
+// out[r][0 .. kColBlock) = bias + in[r] · w for R rows. The R x 4 accumulators stay in registers
+// and each weight vector is loaded once per R rows. `stride` is the row length of w and out.
+template <int R>
+inline void denseBlock(
+    const float* in,
+    int          inputs,
+    const float* w,
+    const float* bias,
+    int          stride,
+    float*       out)
+{
+    Vec acc[R][4];
+    for (int c = 0; c < 4; ++c)
+    {
+        const Vec b = load(bias + c * kLanes);
+        for (int r = 0; r < R; ++r)
+            acc[r][c] = b;
+    }
+
+    for (int i = 0; i < inputs; ++i)
+    {
+        const float* wi = w + static_cast<std::size_t>(i) * stride;
+        const Vec    w0 = load(wi);
+        const Vec    w1 = load(wi + kLanes);
+        const Vec    w2 = load(wi + 2 * kLanes);
+        const Vec    w3 = load(wi + 3 * kLanes);
+        for (int r = 0; r < R; ++r)
+        {
+            const Vec x = splat(in[r * inputs + i]);
+            acc[r][0]   = fmadd(x, w0, acc[r][0]);
+            acc[r][1]   = fmadd(x, w1, acc[r][1]);
+            acc[r][2]   = fmadd(x, w2, acc[r][2]);
+            acc[r][3]   = fmadd(x, w3, acc[r][3]);
+        }
+    }
+
+    for (int r = 0; r < R; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+            store(out + r * stride + c * kLanes, acc[r][c]);
+    }
+}
+
+// out[rows][outputs] = in[rows][inputs] · w[inputs][outputs] + bias
+void dense(
+    const float* in,
+    int          rows,
+    int          inputs,
+    const float* w,
+    const float* bias,
+    int          outputs,
+    float*       out)
+{
+    int o = 0;
+    for (; o + kColBlock <= outputs; o += kColBlock)
+    {
+        int r = 0;
+        for (; r + kRowBlock <= rows; r += kRowBlock)
+        {
+            denseBlock<kRowBlock>(
+                in + r * inputs, inputs, w + o, bias + o, outputs, out + r * outputs + o);
+        }
+        for (; r < rows; ++r)
+            denseBlock<1>(in + r * inputs, inputs, w + o, bias + o, outputs, out + r * outputs + o);
+    }
+
+    // Columns left over (the narrow output layer): plain dot products
+    for (; o < outputs; ++o)
+    {
+        for (int r = 0; r < rows; ++r)
+        {
+            float sum = bias[o];
+            for (int i = 0; i < inputs; ++i)
+                sum += in[r * inputs + i] * w[static_cast<std::size_t>(i) * outputs + o];
+            out[r * outputs + o] = sum;
+        }
+    }
+}
+
+// Rational approximation of tanh (the one Eigen uses): within a few ulp of std::tanh, with no
+// branches or libm calls
+inline Vec tanh(Vec x)
+{
+    constexpr float kClamp = 7.90531110763549805f; // tanh rounds to ±1 beyond this
+    x                      = min(max(x, splat(-kClamp)), splat(kClamp));
+    const Vec x2           = mul(x, x);
+
+    Vec p = splat(-2.76076847742355e-16f);
+    p     = fmadd(p, x2, splat(2.00018790482477e-13f));
+    p     = fmadd(p, x2, splat(-8.60467152213735e-11f));
+    p     = fmadd(p, x2, splat(5.12229709037114e-08f));
+    p     = fmadd(p, x2, splat(1.48572235717979e-05f));
+    p     = fmadd(p, x2, splat(6.37261928875436e-04f));
+    p     = fmadd(p, x2, splat(4.89352455891786e-03f));
+
+    Vec q = splat(1.19825839466702e-06f);
+    q     = fmadd(q, x2, splat(1.18534705686654e-04f));
+    q     = fmadd(q, x2, splat(2.26843463243900e-03f));
+    q     = fmadd(q, x2, splat(4.89352518554385e-03f));
+    return div(mul(x, p), q);
+}
+
+// In place over `count` values rounded up to whole registers; the buffers carry the slack
+void activate(NativeMlp::Activation activation, float* values, int count)
+{
+    const Vec half = splat(0.5f);
+    const Vec zero = splat(0.f);
+    for (int i = 0; i < count; i += kLanes)
+    {
+        const Vec v = load(values + i);
+        switch (activation)
+        {
+        case NativeMlp::Activation::Identity:
+            return;
+        case NativeMlp::Activation::Tanh:
+            store(values + i, tanh(v));
+            break;
+        case NativeMlp::Activation::Relu:
+            store(values + i, max(v, zero));
+            break;
+        case NativeMlp::Activation::Sigmoid:
+            store(values + i, fmadd(half, tanh(mul(half, v)), half));
+            break;
+        }
+    }
+}
+
+// Widens [lo, hi] to cover values[0 .. count): kLanes-wide running min / max, then the tail
+void extendRange(const float* values, int count, float& lo, float& hi)
+{
+    int i = 0;
+    if (count >= kLanes)
+    {
+        Vec vlo = load(values);
+        Vec vhi = vlo;
+        for (i = kLanes; i + kLanes <= count; i += kLanes)
+        {
+            const Vec v = load(values + i);
+            vlo         = min(vlo, v);
+            vhi         = max(vhi, v);
+        }
+
+        float lanes[kLanes];
+        store(lanes, vlo);
+        for (float v : lanes)
+            lo = std::min(lo, v);
+        store(lanes, vhi);
+        for (float v : lanes)
+            hi = std::max(hi, v);
+    }
+    for (; i < count; ++i)
+    {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+}
+} // namespace
+
+bool NativeMlp::isNativeFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    char          magic[4] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::unique_ptr<NativeMlp> NativeMlp::load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    FileHeader    header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion
+        || header.layers > kMaxLayers)
+    {
+        std::cerr << "Not a native model (version " << kVersion << "): " << path << "\n";
+        return nullptr;
+    }
+
+    std::vector<Layer> layers(header.layers);
+    for (Layer& layer : layers)
+    {
+        LayerHeader lh{};
+        if (!in.read(reinterpret_cast<char*>(&lh), sizeof(lh)) || lh.inputs == 0
+            || lh.outputs == 0 || lh.inputs > kMaxWidth || lh.outputs > kMaxWidth
+            || lh.activation > static_cast<std::uint32_t>(Activation::Sigmoid))
+        {
+            std::cerr << "Corrupt layer header in " << path << "\n";
+            return nullptr;
+        }
+        layer.inputs     = static_cast<int>(lh.inputs);
+        layer.outputs    = static_cast<int>(lh.outputs);
+        layer.activation = static_cast<Activation>(lh.activation);
+        layer.weight.resize(static_cast<std::size_t>(lh.inputs) * lh.outputs);
+        layer.bias.resize(lh.outputs);
+        if (!in.read(reinterpret_cast<char*>(layer.weight.data()), layer.weight.size() * 4)
+            || !in.read(reinterpret_cast<char*>(layer.bias.data()), layer.bias.size() * 4))
+        {
+            std::cerr << "Truncated native model: " << path << "\n";
+            return nullptr;
+        }
+    }
+    return fromLayers(std::move(layers));
+}
+
+std::unique_ptr<NativeMlp> NativeMlp::fromLayers(std::vector<Layer> layers)
+{
+    if (layers.empty() || layers.front().inputs != 1 || layers.back().outputs < 2)
+    {
+        std::cerr << "Native model: expected one input and at least two outputs\n";
+        return nullptr;
+    }
+
+    auto mlp = std::make_unique<NativeMlp>();
+    for (std::size_t i = 0; i < layers.size(); ++i)
+    {
+        const Layer& layer = layers[i];
+        if ((i > 0 && layer.inputs != layers[i - 1].outputs)
+            || layer.weight.size() != static_cast<std::size_t>(layer.inputs) * layer.outputs
+            || layer.bias.size() != static_cast<std::size_t>(layer.outputs))
+        {
+            std::cerr << "Native model: layer " << i << " does not chain\n";
+            return nullptr;
+        }
+        mlp->max_width_ = std::max({mlp->max_width_, layer.inputs, layer.outputs});
+    }
+    mlp->layers_ = std::move(layers);
+    return mlp;
+}
+
+bool NativeMlp::save(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    FileHeader    header{{kMagic[0], kMagic[1], kMagic[2], kMagic[3]},
+                      kVersion,
+                      static_cast<std::uint32_t>(layers_.size()),
+                      0};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Layer& layer : layers_)
+    {
+        const LayerHeader lh{
+            static_cast<std::uint32_t>(layer.inputs),
+            static_cast<std::uint32_t>(layer.outputs),
+            static_cast<std::uint32_t>(layer.activation),
+            0};
+        out.write(reinterpret_cast<const char*>(&lh), sizeof(lh));
+        out.write(reinterpret_cast<const char*>(layer.weight.data()), layer.weight.size() * 4);
+        out.write(reinterpret_cast<const char*>(layer.bias.data()), layer.bias.size() * 4);
+    }
+    out.close();
+    if (!out)
+    {
+        std::cerr << "Failed to write native model " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool NativeMlp::forward(
+    const float* input,
+    int          count,
+    float*       col1,
+    float*       col2,
+    float&       y_min,
+    float&       y_max)
+{
+    // Two ping-pong activation buffers of one tile each, plus a register of slack for activate()
+    const std::size_t  tile = static_cast<std::size_t>(kTileRows) * max_width_ + kLanes;
+    std::vector<float> buffers(2 * tile);
+    float*             ping = buffers.data();
+    float*             pong = ping + tile;
+
+    for (int row = 0; row < count; row += kTileRows)
+    {
+        const int    rows = std::min(kTileRows, count - row);
+        const float* in   = input + row; // [rows][1]
+        float*       out  = ping;
+        for (const Layer& layer : layers_)
+        {
+            dense(
+                in,
+                rows,
+                layer.inputs,
+                layer.weight.data(),
+                layer.bias.data(),
+                layer.outputs,
+                out);
+            activate(layer.activation, out, rows * layer.outputs);
+            in  = out;
+            out = out == ping ? pong : ping;
+        }
+
+        const int stride = layers_.back().outputs;
+        for (int r = 0; r < rows; ++r)
+        {
+            col1[row + r] = in[r * stride];
+            col2[row + r] = in[r * stride + 1];
+        }
+    }
+
+    extendRange(col1, count, y_min, y_max);
+    extendRange(col2, count, y_min, y_max);
+    return true;
+}
+
+std::size_t NativeMlp::weightBytes() const
+{
+    std::size_t bytes = 0;
+    for (const Layer& layer : layers_)
+        bytes += (layer.weight.size() + layer.bias.size()) * sizeof(float);
+    return bytes;
+}
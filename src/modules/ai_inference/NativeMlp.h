@@ -0,0 +1,79 @@
+#ifndef NATIVE_MLP_H
+#define NATIVE_MLP_H
+
+#include "InferenceBackend.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Small dense networks run without libtorch.
+ *
+ * The weights come from a file written by pinn_export (save()): "PMLP", the format version and
+ * the layer count, then for each layer its input and output width and activation, followed by
+ * the weight [inputs][outputs] and bias [outputs] as native-endian float32. That is the layout
+ * of the traced model's MatMul / Add buffers, so exporting is a plain copy.
+ *
+ * forward() walks the batch in tiles of rows that stay in L1 and computes each layer as a
+ * register-blocked GEMM: NEON, AVX2 + FMA or SSE2 when the compiler targets them, plain C++
+ * otherwise. The model input is one scalar per row and the first two outputs are returned, as
+ * with the TorchScript PINN.
+ */
+class NativeMlp : public InferenceBackend
+{
+  public:
+    enum class Activation : std::uint32_t
+    {
+        Identity,
+        Tanh,
+        Relu,
+        Sigmoid
+    };
+
+    struct Layer
+    {
+        int                inputs     = 0;
+        int                outputs    = 0;
+        Activation         activation = Activation::Identity;
+        std::vector<float> weight; // [inputs][outputs]
+        std::vector<float> bias;   // [outputs]
+    };
+
+    // True if the file starts with the native model magic
+    static bool isNativeFile(const std::string& path);
+
+    static std::unique_ptr<NativeMlp> load(const std::string& path);
+
+    // nullptr if the layers do not chain (widths, array sizes, scalar input, two outputs)
+    static std::unique_ptr<NativeMlp> fromLayers(std::vector<Layer> layers);
+
+    bool save(const std::string& path) const;
+
+    bool forward(
+        const float* input,
+        int          count,
+        float*       col1,
+        float*       col2,
+        float&       y_min,
+        float&       y_max) override;
+
+    std::size_t weightBytes() const override;
+
+    const char* name() const override
+    {
+        return "native";
+    }
+
+    const std::vector<Layer>& layers() const
+    {
+        return layers_;
+    }
+
+  private:
+    std::vector<Layer> layers_;
+    int                max_width_ = 0;
+};
+
+#endif // NATIVE_MLP_H
@@ -0,0 +1,55 @@
+#include "SeriesDecimator.h"
+
+#include <algorithm>
+
+namespace SeriesDecimator
+{
+void decimate(
+    const float*        x,
+    const float*        y,
+    std::size_t         count,
+    float               xMin,
+    float               xMax,
+    int                 columns,
+    std::vector<Point>& out)
+{
+    out.clear();
+    if (count == 0 || columns <= 0)
+        return;
+
+    const float scale    = xMax > xMin ? (columns - 1) / (xMax - xMin) : 0.f;
+    auto        columnOf = [&](std::size_t i)
+    {
+        return std::clamp(static_cast<int>((x[i] - xMin) * scale), 0, columns - 1);
+    };
+
+    // Emit the column's first, min, max and last sample, each once, in sample order
+    auto flush = [&](std::size_t first, std::size_t lo, std::size_t hi, std::size_t last)
+    {
+        std::size_t idx[4] = {first, lo, hi, last};
+        std::sort(idx, idx + 4);
+        const std::size_t* end = std::unique(idx, idx + 4);
+        for (const std::size_t* i = idx; i != end; ++i)
+            out.push_back({x[*i], y[*i]});
+    };
+
+    int         column = columnOf(0);
+    std::size_t first = 0, lo = 0, hi = 0;
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        const int c = columnOf(i);
+        if (c != column)
+        {
+            flush(first, lo, hi, i - 1);
+            column = c;
+            first = lo = hi = i;
+            continue;
+        }
+        if (y[i] < y[lo])
+            lo = i;
+        if (y[i] > y[hi])
+            hi = i;
+    }
+    flush(first, lo, hi, count - 1);
+}
+} // namespace SeriesDecimator
@@ -0,0 +1,33 @@
+#ifndef SERIES_DECIMATOR_H
+#define SERIES_DECIMATOR_H
+
+#include <cstddef>
+#include <vector>
+
+// Reduces a line series to what can be seen at a given pixel width (M4 decimation).
+//
+// Each pixel column keeps only its first, minimum, maximum and last sample, in x order. Drawn as
+// a polyline at that width this rasterises exactly like the full series, but costs at most four
+// points per column, so plotting time no longer depends on the number of samples.
+namespace SeriesDecimator
+{
+struct Point
+{
+    float x;
+    float y;
+};
+
+// `x` must be non-decreasing. Columns are those of a (columns - 1) / (xMax - xMin) pixel scale:
+// xMin falls in the first, xMax in the last, anything outside is clamped to the edges.
+// `out` is cleared first; its capacity is reused across calls.
+void decimate(
+    const float*        x,
+    const float*        y,
+    std::size_t         count,
+    float               xMin,
+    float               xMax,
+    int                 columns,
+    std::vector<Point>& out);
+} // namespace SeriesDecimator
+
+#endif // SERIES_DECIMATOR_H
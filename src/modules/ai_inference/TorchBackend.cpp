@@ -0,0 +1,88 @@
+#include "TorchBackend.h"
+
+#include <algorithm>
+#include <iostream>
+
+std::unique_ptr<TorchBackend> TorchBackend::load(
+    const std::string& model_path,
+    Optimization       optimization)
+{
+    auto backend = std::make_unique<TorchBackend>();
+    try
+    {
+        backend->module_ = torch::jit::load(model_path);
+        backend->module_.eval();
+        backend->weight_bytes_ = ModelOptimizer::weightBytes(backend->module_);
+
+        switch (optimization)
+        {
+        case Optimization::None:
+            break;
+        case Optimization::Frozen:
+            // Weights become constants
+            backend->module_ = ModelOptimizer::freezeForInference(backend->module_);
+            break;
+        case Optimization::DynamicInt8:
+            backend->int8_ = ModelOptimizer::QuantizedMlp::fromModule(backend->module_);
+            if (!backend->int8_)
+                return nullptr;
+            backend->weight_bytes_ = backend->int8_->weightBytes();
+            break;
+        }
+    }
+    catch (const c10::Error& e)
+    {
+        std::cerr << "Error loading the model: " << e.what() << "\n";
+        return nullptr;
+    }
+    return backend;
+}
+
+bool TorchBackend::forward(
+    const float* input,
+    int          count,
+    float*       col1,
+    float*       col2,
+    float&       y_min,
+    float&       y_max)
+{
+    try
+    {
+        // A view of the caller's buffer (no copy); the model only reads its input
+        c10::InferenceMode guard;
+
+        auto          options = torch::TensorOptions().dtype(torch::kFloat32);
+        torch::Tensor x       = torch::from_blob(const_cast<float*>(input), {count, 1}, options);
+        at::Tensor    output  = int8_ ? int8_->forward(x) : module_.forward({x}).toTensor();
+
+        auto sizes = output.sizes();
+        if (sizes.size() != 2 || sizes[0] != count || sizes[1] < 2)
+        {
+            std::cerr << "Unexpected output tensor shape\n";
+            return false;
+        }
+
+        // One dense float block (no-ops for the usual float32 row-major output)
+        output = output.to(torch::kFloat32).contiguous();
+
+        // Split the two columns straight from the row-major data
+        const float*  out    = output.data_ptr<float>();
+        const int64_t stride = sizes[1];
+        for (int64_t i = 0; i < count; ++i)
+        {
+            col1[i] = out[i * stride];
+            col2[i] = out[i * stride + 1];
+        }
+
+        // Vectorised ATen reduction over both columns
+        const auto [min_val, max_val] = torch::aminmax(output.narrow(1, 0, 2));
+        y_min                         = std::min(y_min, min_val.item<float>());
+        y_max                         = std::max(y_max, max_val.item<float>());
+    }
+    catch (const c10::Error& e)
+    {
+        std::cerr << "Error evaluating the model: " << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
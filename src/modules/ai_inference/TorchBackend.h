@@ -0,0 +1,42 @@
+#ifndef TORCH_BACKEND_H
+#define TORCH_BACKEND_H
+
+#include "InferenceBackend.h"
+#include "ModelOptimizer.h"
+
+#include <torch/script.h>
+
+// TorchScript models through libtorch, with the optional ModelOptimizer transformations
+class TorchBackend : public InferenceBackend
+{
+  public:
+    static std::unique_ptr<TorchBackend> load(
+        const std::string& model_path,
+        Optimization       optimization);
+
+    bool forward(
+        const float* input,
+        int          count,
+        float*       col1,
+        float*       col2,
+        float&       y_min,
+        float&       y_max) override;
+
+    std::size_t weightBytes() const override
+    {
+        return weight_bytes_;
+    }
+
+    const char* name() const override
+    {
+        return int8_ ? "torch-int8" : "torch";
+    }
+
+  private:
+    torch::jit::script::Module module_;
+    std::size_t                weight_bytes_ = 0;
+
+    std::shared_ptr<const ModelOptimizer::QuantizedMlp> int8_; // replaces module_ if set
+};
+
+#endif // TORCH_BACKEND_H
@@ -1,217 +1,281 @@
 #include "contourExtractor.h"
+#include "../svgPath/svgPath.h"
 
 #include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <opencv2/opencv.hpp>
-#include <sstream>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace KamonFourier::ContourExtractor
 {
+namespace
+{
+// Absolute shoelace area of a (closed or implicitly closed) polygon
+float polygonArea(std::span<const sf::Vector2f> pts)
+{
+    double twiceArea = 0.0;
+    for (std::size_t i = 0, j = pts.size() - 1; i < pts.size(); j = i++)
+        twiceArea += static_cast<double>(pts[j].x) * pts[i].y
+                     - static_cast<double>(pts[i].x) * pts[j].y;
+    return static_cast<float>(std::abs(twiceArea) * 0.5);
+}
 
-std::vector<sf::Vector2f> extractLargestContour(const std::string& imagePath)
+// Sort contours by area (largest first) and drop those below `minAreaFraction` of the largest
+std::vector<std::vector<sf::Vector2f>> sortByArea(
+    std::vector<std::vector<sf::Vector2f>> contours,
+    const std::vector<float>&              areas,
+    float                                  minAreaFraction)
 {
-    cv::Mat img = cv::imread(imagePath, cv::IMREAD_GRAYSCALE);
-    if (img.empty())
+    std::vector<std::size_t> order(contours.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(
+        order.begin(),
+        order.end(),
+        [&](std::size_t a, std::size_t b) { return areas[a] > areas[b]; });
+
+    std::vector<std::vector<sf::Vector2f>> sorted;
+    sorted.reserve(contours.size());
+    const float minArea = order.empty() ? 0.f : areas[order.front()] * minAreaFraction;
+    for (const std::size_t i : order)
     {
-        std::cerr << "[KamonFourier] Failed to load image: " << imagePath << std::endl;
-        return {};
+        if (areas[i] >= minArea && contours[i].size() >= 2)
+            sorted.push_back(std::move(contours[i]));
+    }
+    return sorted;
+}
+
+bool readFile(const std::string& path, std::string& content)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return false;
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Bounding box of the ink, found on a pyramid level no larger than `maxSide`.
+// The reduced pass uses a lenient threshold because pyrDown blurs thin strokes towards white,
+// and the box is padded by the blur footprint, so it always contains the full-resolution ink.
+cv::Rect findInkRegion(const cv::Mat& img, int maxSide)
+{
+    const cv::Rect whole(0, 0, img.cols, img.rows);
+    if (maxSide <= 0 || std::max(img.cols, img.rows) <= maxSide)
+        return whole;
+
+    cv::Mat small = img;
+    int     scale = 1;
+    while (std::max(small.cols, small.rows) > maxSide)
+    {
+        cv::Mat next;
+        cv::pyrDown(small, next);
+        small = std::move(next);
+        scale *= 2;
     }
 
+    cv::Mat mask;
+    cv::threshold(small, mask, 250, 255, cv::THRESH_BINARY_INV);
+    const cv::Rect box = cv::boundingRect(mask);
+    if (box.empty())
+        return {};
+
+    const int pad = 2 * scale;
+    return cv::Rect(
+               box.x * scale - pad,
+               box.y * scale - pad,
+               box.width * scale + 2 * pad,
+               box.height * scale + 2 * pad)
+           & whole;
+}
+
+// Threshold and trace the dark shapes of `img`, restricted to the ink region.
+// Contours come back in full-image coordinates.
+std::vector<std::vector<cv::Point>>
+traceContours(const cv::Mat& img, int mode, const TraceOptions& options)
+{
+    const cv::Rect roi = findInkRegion(img, options.roiMaxSide);
+    if (roi.empty())
+        return {};
+
     cv::Mat thresh;
-    cv::threshold(img, thresh, 127, 255, cv::THRESH_BINARY_INV);
+    cv::threshold(img(roi), thresh, 127, 255, cv::THRESH_BINARY_INV);
 
     std::vector<std::vector<cv::Point>> contours;
-    cv::findContours(thresh, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+    cv::findContours(thresh, contours, mode, cv::CHAIN_APPROX_NONE, roi.tl());
+    return contours;
+}
 
-    if (contours.empty())
+// Simplify (Douglas–Peucker, closed) and convert to SFML coordinates with Y flipped
+std::vector<sf::Vector2f> toPoints(const std::vector<cv::Point>& contour, float epsilon)
+{
+    std::vector<cv::Point> simplified;
+    if (epsilon > 0.f && contour.size() > 3)
+        cv::approxPolyDP(contour, simplified, epsilon, true);
+    const auto& src = simplified.empty() ? contour : simplified;
+
+    std::vector<sf::Vector2f> points;
+    points.reserve(src.size());
+    for (const auto& pt : src)
+        points.emplace_back(static_cast<float>(pt.x), static_cast<float>(-pt.y)); // flip Y
+    return points;
+}
+} // namespace
+
+std::vector<sf::Vector2f>
+extractLargestContour(const std::string& imagePath, const TraceOptions& options)
+{
+    cv::Mat img = cv::imread(imagePath, cv::IMREAD_GRAYSCALE);
+    if (img.empty())
     {
-        std::cerr << "[KamonFourier] No contours found.\n";
+        std::cerr << "[KamonFourier] Failed to load image: " << imagePath << std::endl;
         return {};
     }
 
-    auto largestIt = std::max_element(
-        contours.begin(),
-        contours.end(),
-        [](const auto& a, const auto& b) { return cv::contourArea(a) < cv::contourArea(b); });
-
-    std::vector<sf::Vector2f> points;
-    points.reserve(largestIt->size());
-    for (const auto& pt : *largestIt)
+    const auto contours = traceContours(img, cv::RETR_EXTERNAL, options);
+    if (contours.empty())
     {
-        points.emplace_back(static_cast<float>(pt.x), static_cast<float>(-pt.y)); // flip Y
+        std::cerr << "[KamonFourier] No contours found.\n";
+        return {};
     }
 
-    return points;
+    // One area per contour, then a plain argmax
+    std::vector<double> areas(contours.size());
+    for (std::size_t i = 0; i < contours.size(); ++i)
+        areas[i] = cv::contourArea(contours[i]);
+    const auto largest = std::max_element(areas.begin(), areas.end()) - areas.begin();
+
+    return toPoints(contours[largest], options.simplifyEpsilon);
 }
 
-std::vector<sf::Vector2f> extractContourFromSVG(const std::string& svgPath)
+std::vector<sf::Vector2f> extractContourFromSVG(const std::string& svgPath, float tolerance)
 {
     // ---------- load SVG file ------------------------------------------------
-    std::ifstream in(svgPath);
-    if (!in.is_open())
+    std::string content;
+    if (!readFile(svgPath, content))
     {
         std::cerr << "[KamonFourier] Failed to open SVG file: " << svgPath << '\n';
         return {};
     }
-    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
-    in.close();
 
     // ---------- pull out the first path's ‘d’ attribute ----------------------
-    const std::size_t pathPos = content.find("<path");
-    if (pathPos == std::string::npos)
+    std::size_t            pos      = 0;
+    const std::string_view pathData = SvgPath::nextPathData(content, pos);
+    if (pathData.empty())
     {
-        std::cerr << "[KamonFourier] No <path> element found in SVG.\n";
+        std::cerr << "[KamonFourier] No <path d=…> element found in SVG.\n";
         return {};
     }
-    std::size_t dPos = content.find(" d=", pathPos);
-    if (dPos == std::string::npos)
-        dPos = content.find("d=", pathPos);
-    if (dPos == std::string::npos)
+
+    // ---------- parse + flatten ---------------------------------------------
+    SvgPath::Subpaths subpaths;
+    if (!SvgPath::parse(pathData, tolerance, subpaths))
+        std::cerr << "[KamonFourier] Malformed SVG path data, using what parsed.\n";
+
+    if (subpaths.count() == 0)
     {
-        std::cerr << "[KamonFourier] No d= attribute in <path>.\n";
+        std::cerr << "[KamonFourier] No valid points extracted from SVG.\n";
         return {};
     }
 
-    const std::size_t firstQuote  = content.find('"', dPos);
-    const std::size_t secondQuote = content.find('"', firstQuote + 1);
-    if (firstQuote == std::string::npos || secondQuote == std::string::npos)
+    // Like the PNG path: keep the subpath enclosing the largest area
+    std::size_t best     = 0;
+    float       bestArea = -1.f;
+    for (std::size_t i = 0; i < subpaths.count(); ++i)
     {
-        std::cerr << "[KamonFourier] Malformed path data string.\n";
-        return {};
+        const float area = polygonArea(subpaths.subpath(i));
+        if (area > bestArea)
+        {
+            bestArea = area;
+            best     = i;
+        }
     }
 
-    std::string pathData = content.substr(firstQuote + 1, secondQuote - firstQuote - 1);
-
-    // Replace commas with spaces so we can treat both uniformly
-    std::replace(pathData.begin(), pathData.end(), ',', ' ');
+    const auto contour = subpaths.subpath(best);
+    return {contour.begin(), contour.end()};
+}
 
-    // ---------- helpers ------------------------------------------------------
-    auto skipDelim = [](std::istringstream& iss)
+std::vector<std::vector<sf::Vector2f>> extractAllContours(
+    const std::string&  imagePath,
+    float               minAreaFraction,
+    const TraceOptions& options)
+{
+    cv::Mat img = cv::imread(imagePath, cv::IMREAD_GRAYSCALE);
+    if (img.empty())
     {
-        while (iss && (std::isspace(iss.peek()) || iss.peek() == ','))
-            iss.ignore();
-    };
+        std::cerr << "[KamonFourier] Failed to load image: " << imagePath << std::endl;
+        return {};
+    }
 
-    // ---------- main parse loop ---------------------------------------------
-    std::vector<sf::Vector2f> points;
-    sf::Vector2f              currentPos(0.f, 0.f);
-    char                      cmd = 0; // current command (persists if coords repeat)
+    // RETR_LIST: outer outlines and the holes / inner details of the crest
+    const auto cvContours = traceContours(img, cv::RETR_LIST, options);
 
-    std::istringstream iss(pathData);
-    while (iss)
+    std::vector<std::vector<sf::Vector2f>> contours(cvContours.size());
+    std::vector<float>                     areas(cvContours.size());
+    for (std::size_t i = 0; i < cvContours.size(); ++i)
     {
-        skipDelim(iss);
-        if (!iss.good())
-            break;
+        areas[i]    = static_cast<float>(cv::contourArea(cvContours[i]));
+        contours[i] = toPoints(cvContours[i], options.simplifyEpsilon);
+    }
 
-        // If next char is a letter, that's the new command
-        if (std::isalpha(iss.peek()))
-        {
-            iss >> cmd;
-            skipDelim(iss);
-        }
-        if (!cmd)
-            break; // malformed data
+    auto sorted = sortByArea(std::move(contours), areas, minAreaFraction);
+    if (sorted.empty())
+        std::cerr << "[KamonFourier] No contours found.\n";
+    return sorted;
+}
 
-        const bool relative = std::islower(cmd);
-        const char op       = static_cast<char>(std::toupper(cmd));
+bool isSvgFile(const std::string& path)
+{
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(
+        ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".svg";
+}
 
-        // ---------- M / m  (move-to) ----------------------------------------
-        if (op == 'M')
-        {
-            float x, y;
-            if (!(iss >> x >> y))
-                break;
-
-            if (relative)
-            {
-                x += currentPos.x;
-                y += currentPos.y;
-            }
-            currentPos = {x, y};
-            points.push_back(currentPos);
-
-            // Any additional coord‐pairs after an M/m are treated as L/l
-            cmd = relative ? 'l' : 'L';
-        }
-        // ---------- L / l  (line-to) ----------------------------------------
-        else if (op == 'L')
-        {
-            float x, y;
-            while (iss >> x >> y)
-            {
-                if (relative)
-                {
-                    x += currentPos.x;
-                    y += currentPos.y;
-                }
-                currentPos = {x, y};
-                points.push_back(currentPos);
-
-                skipDelim(iss);
-                if (std::isalpha(iss.peek()))
-                    break; // next explicit command
-            }
-        }
-        // ---------- C / c  (cubic bézier) -----------------------------------
-        else if (op == 'C')
-        {
-            const int NUM_SAMPLES = 30;
-            float     x1, y1, x2, y2, x3, y3;
-            while (iss >> x1 >> y1 >> x2 >> y2 >> x3 >> y3)
-            {
-                if (relative)
-                {
-                    x1 += currentPos.x;
-                    y1 += currentPos.y;
-                    x2 += currentPos.x;
-                    y2 += currentPos.y;
-                    x3 += currentPos.x;
-                    y3 += currentPos.y;
-                }
-                // Sample the curve
-                for (int i = 1; i <= NUM_SAMPLES; ++i)
-                {
-                    const float t  = static_cast<float>(i) / NUM_SAMPLES;
-                    const float mt = 1.f - t;
-                    const float bx = mt * mt * mt * currentPos.x + 3 * mt * mt * t * x1
-                                     + 3 * mt * t * t * x2 + t * t * t * x3;
-                    const float by = mt * mt * mt * currentPos.y + 3 * mt * mt * t * y1
-                                     + 3 * mt * t * t * y2 + t * t * t * y3;
-                    points.emplace_back(bx, by);
-                }
-                currentPos = {x3, y3};
-
-                skipDelim(iss);
-                if (std::isalpha(iss.peek()))
-                    break;
-            }
-        }
-        // ---------- Z / z  (close path) -------------------------------------
-        else if (op == 'Z')
-        {
-            if (!points.empty())
-                points.push_back(points.front()); // optional: close contour
-            cmd = 0;                              // force consumption of next explicit command
-        }
-        // ---------- unsupported --------------------------------------------
-        else
-        {
-            std::cerr << "[KamonFourier] Unhandled SVG path command: " << cmd << '\n';
-            break;
-        }
-    }
+std::vector<sf::Vector2f> extractShapeContour(const std::string& path)
+{
+    return isSvgFile(path) ? extractContourFromSVG(path) : extractLargestContour(path);
+}
 
-    if (points.size() < 2)
+std::vector<std::vector<sf::Vector2f>>
+extractAllContoursFromSVG(const std::string& svgPath, float tolerance, float minAreaFraction)
+{
+    std::string content;
+    if (!readFile(svgPath, content))
     {
-        std::cerr << "[KamonFourier] No valid points extracted from SVG.\n";
+        std::cerr << "[KamonFourier] Failed to open SVG file: " << svgPath << '\n';
         return {};
     }
 
-    return points;
+    // Every subpath of every <path> element
+    SvgPath::Subpaths subpaths;
+    std::size_t       pos = 0;
+    for (auto d = SvgPath::nextPathData(content, pos); !d.empty();
+         d      = SvgPath::nextPathData(content, pos))
+    {
+        if (!SvgPath::parse(d, tolerance, subpaths))
+            std::cerr << "[KamonFourier] Malformed SVG path data, using what parsed.\n";
+    }
+
+    std::vector<std::vector<sf::Vector2f>> contours(subpaths.count());
+    std::vector<float>                     areas(subpaths.count());
+    for (std::size_t i = 0; i < subpaths.count(); ++i)
+    {
+        const auto sub = subpaths.subpath(i);
+        contours[i].assign(sub.begin(), sub.end());
+        areas[i] = polygonArea(sub);
+    }
+
+    auto sorted = sortByArea(std::move(contours), areas, minAreaFraction);
+    if (sorted.empty())
+        std::cerr << "[KamonFourier] No valid points extracted from SVG.\n";
+    return sorted;
 }
 
 } // namespace KamonFourier::ContourExtractor
@@ -6,9 +6,40 @@
 
 namespace KamonFourier::ContourExtractor
 {
+// Raster tracing options (PNG / JPG scans)
+struct TraceOptions
+{
+    // Douglas–Peucker error bound in source pixels; 0 keeps every boundary pixel
+    float simplifyEpsilon = 1.0f;
+    // Images whose longest side exceeds this are first scanned at a reduced pyramid level to
+    // find the region holding the crest; 0 always traces the whole image
+    int roiMaxSide = 1024;
+};
+
 // Load the largest contour from a grayscale PNG image
-std::vector<sf::Vector2f> extractLargestContour(const std::string& imagePath);
+std::vector<sf::Vector2f>
+extractLargestContour(const std::string& imagePath, const TraceOptions& options = {});
+
+// Load the first SVG path (full path grammar) and return its largest subpath.
+// Curves are flattened adaptively to within `tolerance` path units.
+std::vector<sf::Vector2f>
+extractContourFromSVG(const std::string& svgPath, float tolerance = 0.25f);
+
+// Whether `path` names an SVG file (extension compared case-insensitively)
+bool isSvgFile(const std::string& path);
+
+// Largest contour of a shape file: extractContourFromSVG() for SVG files (isSvgFile),
+// extractLargestContour() for raster images
+std::vector<sf::Vector2f> extractShapeContour(const std::string& path);
+
+// Load every contour of a grayscale image (outlines and inner details), largest first.
+// Contours smaller than `minAreaFraction` of the largest one are dropped.
+std::vector<std::vector<sf::Vector2f>> extractAllContours(
+    const std::string&  imagePath,
+    float               minAreaFraction = 0.001f,
+    const TraceOptions& options         = {});
 
-// Load a single SVG path (only M, L, C commands supported — absolute only)
-std::vector<sf::Vector2f> extractContourFromSVG(const std::string& svgPath);
+// Load every subpath of every SVG path, largest first (same filtering as above)
+std::vector<std::vector<sf::Vector2f>> extractAllContoursFromSVG(
+    const std::string& svgPath, float tolerance = 0.25f, float minAreaFraction = 0.001f);
 } // namespace KamonFourier::ContourExtractor
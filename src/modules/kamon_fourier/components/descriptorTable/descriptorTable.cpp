@@ -0,0 +1,141 @@
+#include "descriptorTable.h"
+
+#include "../../../../io/csv_writer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace KamonFourier::DescriptorTable
+{
+namespace
+{
+constexpr char          kMagic[4]   = {'K', 'F', 'D', '1'};
+constexpr std::uint32_t kMaxEntries = 1u << 24; // sanity bound for corrupt files
+
+template <typename T>
+void writePod(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::ifstream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+} // namespace
+
+bool writeCSV(const std::string& filename, const std::vector<Record>& records)
+{
+    CsvWriter csv;
+    if (!csv.open(filename))
+        return false;
+
+    for (const auto& rec : records)
+    {
+        csv.field(std::string_view(rec.name))
+            .field(rec.numPoints)
+            .field(static_cast<std::uint64_t>(rec.fourier.coeffs.size()));
+        for (std::size_t i = 0; i < rec.fourier.coeffs.size(); ++i)
+        {
+            csv.field(rec.fourier.freqs[i])
+                .field(rec.fourier.coeffs[i].real())
+                .field(rec.fourier.coeffs[i].imag());
+        }
+        csv.endRow();
+    }
+
+    return csv.close();
+}
+
+bool writeBinary(const std::string& filename, const std::vector<Record>& records)
+{
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cerr << "[KamonFourier] Failed to open file: " << filename << '\n';
+        return false;
+    }
+
+    out.write(kMagic, sizeof(kMagic));
+    writePod(out, static_cast<std::uint32_t>(records.size()));
+
+    for (const auto& rec : records)
+    {
+        writePod(out, static_cast<std::uint16_t>(rec.name.size()));
+        out.write(rec.name.data(), static_cast<std::streamsize>(rec.name.size()));
+        writePod(out, rec.numPoints);
+        writePod(out, static_cast<std::uint32_t>(rec.fourier.coeffs.size()));
+        for (std::size_t i = 0; i < rec.fourier.coeffs.size(); ++i)
+        {
+            writePod(out, static_cast<std::int32_t>(rec.fourier.freqs[i]));
+            writePod(out, rec.fourier.coeffs[i].real());
+            writePod(out, rec.fourier.coeffs[i].imag());
+        }
+    }
+
+    return static_cast<bool>(out);
+}
+
+bool readBinary(const std::string& filename, std::vector<Record>& records)
+{
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cerr << "[KamonFourier] Failed to open file: " << filename << '\n';
+        return false;
+    }
+
+    char          magic[4] = {};
+    std::uint32_t count    = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, kMagic)
+        || !readPod(in, count) || count > kMaxEntries)
+    {
+        std::cerr << "[KamonFourier] Not a descriptor table: " << filename << '\n';
+        return false;
+    }
+
+    // Records grow as they are read, so a bogus count fails on the data instead of allocating
+    records.clear();
+    records.reserve(std::min<std::uint32_t>(count, 4096));
+    for (std::uint32_t r = 0; r < count && in; ++r)
+    {
+        Record&       rec     = records.emplace_back();
+        std::uint16_t nameLen = 0;
+        std::uint32_t n       = 0;
+        if (!readPod(in, nameLen))
+            break;
+        rec.name.resize(nameLen);
+        in.read(rec.name.data(), nameLen);
+        if (!readPod(in, rec.numPoints) || !readPod(in, n))
+            break;
+        if (n > kMaxEntries)
+        {
+            in.setstate(std::ios::failbit);
+            break;
+        }
+
+        rec.fourier.coeffs.resize(n);
+        rec.fourier.freqs.resize(n);
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            std::int32_t freq = 0;
+            float        re = 0.f, im = 0.f;
+            if (!readPod(in, freq) || !readPod(in, re) || !readPod(in, im))
+                break;
+            rec.fourier.freqs[i]  = freq;
+            rec.fourier.coeffs[i] = {re, im};
+        }
+    }
+
+    if (!in)
+    {
+        std::cerr << "[KamonFourier] Truncated descriptor table: " << filename << '\n';
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace KamonFourier::DescriptorTable
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../fourierPipeline/fourierPipeline.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KamonFourier::DescriptorTable
+{
+// One processed shape: source name, contour length and its Fourier components
+struct Record
+{
+    std::string                  name;
+    std::uint32_t                numPoints = 0;
+    FourierPipeline::FourierData fourier;
+};
+
+// One line per shape: name,points,components,freq_0,re_0,im_0,...
+bool writeCSV(const std::string& filename, const std::vector<Record>& records);
+
+// Little-endian table: "KFD1", shape count, then per shape
+// name length (u16), name, points (u32), components (u32), {freq i32, re f32, im f32}...
+bool writeBinary(const std::string& filename, const std::vector<Record>& records);
+
+// Read a table written by writeBinary()
+bool readBinary(const std::string& filename, std::vector<Record>& records);
+} // namespace KamonFourier::DescriptorTable
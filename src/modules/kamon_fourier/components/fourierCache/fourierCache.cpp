@@ -0,0 +1,183 @@
+#include "fourierCache.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace KamonFourier::FourierCache
+{
+namespace
+{
+constexpr char          kMagic[4]   = {'K', 'F', 'C', '2'};
+constexpr std::uint64_t kFnvOffset  = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime   = 1099511628211ull;
+constexpr std::uint32_t kMaxEntries = 1u << 24; // sanity bound for corrupt files
+
+void fnv1a(std::uint64_t& hash, const char* data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= kFnvPrime;
+    }
+}
+
+fs::path cacheFile(const std::string& cacheDir, std::uint64_t key)
+{
+    char name[40];
+    std::snprintf(name, sizeof(name), "fourier_%016llx.bin", static_cast<unsigned long long>(key));
+    return fs::path(cacheDir) / name;
+}
+
+template <typename T>
+void writePod(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::ifstream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+} // namespace
+
+std::uint64_t makeKey(const std::string& assetPath, int numComponents)
+{
+    std::ifstream in(assetPath, std::ios::binary);
+    if (!in.is_open())
+        return 0;
+
+    std::uint64_t           hash = kFnvOffset;
+    std::array<char, 65536> buf;
+    while (in.read(buf.data(), buf.size()) || in.gcount() > 0)
+        fnv1a(hash, buf.data(), static_cast<std::size_t>(in.gcount()));
+
+    const std::uint32_t params[] = {kPipelineVersion, static_cast<std::uint32_t>(numComponents)};
+    fnv1a(hash, reinterpret_cast<const char*>(params), sizeof(params));
+
+    return hash != 0 ? hash : 1;
+}
+
+bool load(const std::string& cacheDir, std::uint64_t key, Entry& entry)
+{
+    std::ifstream in(cacheFile(cacheDir, key), std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    in.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::uint64_t>(std::max<std::streamoff>(in.tellg(), 0));
+    in.seekg(0, std::ios::beg);
+
+    // Bytes not read yet; every count is checked against it before anything is allocated
+    auto remaining = [&]
+    {
+        const std::streamoff pos = in.tellg();
+        return pos < 0 ? 0 : fileSize - std::min<std::uint64_t>(fileSize, pos);
+    };
+    constexpr std::uint64_t kChainHeaderBytes = 2 * sizeof(std::uint32_t);
+
+    char          magic[4]  = {};
+    std::uint64_t storedKey = 0;
+    std::uint32_t numChains = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, kMagic)
+        || !readPod(in, storedKey) || storedKey != key || !readPod(in, numChains)
+        || numChains > kMaxEntries || numChains > remaining() / kChainHeaderBytes)
+    {
+        std::cerr << "[KamonFourier] Ignoring stale cache file for key " << key << '\n';
+        return false;
+    }
+
+    static_assert(sizeof(std::complex<float>) == 2 * sizeof(float));
+    static_assert(sizeof(sf::Vector2f) == 2 * sizeof(float));
+
+    Entry tmp;
+    tmp.chains.reserve(numChains);
+    tmp.contours.reserve(numChains);
+    for (std::uint32_t c = 0; c < numChains; ++c)
+    {
+        std::uint32_t numCoeffs = 0, numPoints = 0;
+        if (!readPod(in, numCoeffs) || !readPod(in, numPoints) || numCoeffs > kMaxEntries
+            || numPoints > kMaxEntries)
+            return false;
+
+        const std::uint64_t payload =
+            std::uint64_t{numCoeffs} * (sizeof(std::complex<float>) + sizeof(int))
+            + std::uint64_t{numPoints} * sizeof(sf::Vector2f);
+        if (payload > remaining())
+            return false;
+
+        auto& chain   = tmp.chains.emplace_back();
+        auto& contour = tmp.contours.emplace_back();
+        chain.coeffs.resize(numCoeffs);
+        chain.freqs.resize(numCoeffs);
+        contour.resize(numPoints);
+
+        in.read(
+            reinterpret_cast<char*>(chain.coeffs.data()),
+            static_cast<std::streamsize>(numCoeffs * sizeof(std::complex<float>)));
+        in.read(
+            reinterpret_cast<char*>(chain.freqs.data()),
+            static_cast<std::streamsize>(numCoeffs * sizeof(int)));
+        in.read(
+            reinterpret_cast<char*>(contour.data()),
+            static_cast<std::streamsize>(numPoints * sizeof(sf::Vector2f)));
+        if (!in)
+            return false;
+    }
+
+    entry = std::move(tmp);
+    return true;
+}
+
+bool store(const std::string& cacheDir, std::uint64_t key, const Entry& entry)
+{
+    std::error_code ec;
+    fs::create_directories(cacheDir, ec);
+
+    // Write to a temporary name first so a crash never leaves a half-written entry behind
+    const fs::path target = cacheFile(cacheDir, key);
+    const fs::path tmp    = fs::path(target).concat(".tmp");
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out.is_open())
+        {
+            std::cerr << "[KamonFourier] Failed to write cache file: " << tmp << '\n';
+            return false;
+        }
+
+        out.write(kMagic, sizeof(kMagic));
+        writePod(out, key);
+        writePod(out, static_cast<std::uint32_t>(entry.chains.size()));
+        for (std::size_t c = 0; c < entry.chains.size(); ++c)
+        {
+            const auto&       chain     = entry.chains[c];
+            const auto&       contour   = entry.contours[c];
+            const std::size_t numCoeffs = chain.coeffs.size();
+
+            writePod(out, static_cast<std::uint32_t>(numCoeffs));
+            writePod(out, static_cast<std::uint32_t>(contour.size()));
+            out.write(
+                reinterpret_cast<const char*>(chain.coeffs.data()),
+                static_cast<std::streamsize>(numCoeffs * sizeof(std::complex<float>)));
+            out.write(
+                reinterpret_cast<const char*>(chain.freqs.data()),
+                static_cast<std::streamsize>(numCoeffs * sizeof(int)));
+            out.write(
+                reinterpret_cast<const char*>(contour.data()),
+                static_cast<std::streamsize>(contour.size() * sizeof(sf::Vector2f)));
+        }
+        if (!out)
+            return false;
+    }
+
+    fs::rename(tmp, target, ec);
+    return !ec;
+}
+
+} // namespace KamonFourier::FourierCache
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../fourierPipeline/fourierPipeline.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KamonFourier::FourierCache
+{
+// Bump whenever contour extraction or the Fourier pipeline changes its output
+constexpr std::uint32_t kPipelineVersion = 4;
+
+// Everything initFourierData() would otherwise recompute: one chain per contour
+struct Entry
+{
+    std::vector<FourierPipeline::FourierData> chains;
+    std::vector<std::vector<sf::Vector2f>>    contours; // normalised contours
+};
+
+// 64-bit FNV-1a over the asset bytes plus the pipeline parameters.
+// Returns 0 if the asset cannot be read.
+std::uint64_t makeKey(const std::string& assetPath, int numComponents);
+
+// Load the cache file for `key` from `cacheDir`; false on miss or mismatch
+bool load(const std::string& cacheDir, std::uint64_t key, Entry& entry);
+
+// Write the cache file for `key` into `cacheDir` (created if missing)
+bool store(const std::string& cacheDir, std::uint64_t key, const Entry& entry);
+} // namespace KamonFourier::FourierCache
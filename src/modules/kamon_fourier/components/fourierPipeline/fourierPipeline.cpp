@@ -0,0 +1,240 @@
+#include "fourierPipeline.h"
+
+#include <kissfft/kiss_fft.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+
+namespace KamonFourier::FourierPipeline
+{
+namespace
+{
+using complexf = std::complex<float>;
+
+// ──────────────────────────────────────────────────────────────────────────────
+// RAII helper for kiss_fft_cfg
+// ──────────────────────────────────────────────────────────────────────────────
+struct KissFftDeleter
+{
+    void operator()(kiss_fft_state* cfg) const noexcept
+    {
+        std::free(cfg);
+    }
+};
+using KissFftPtr = std::unique_ptr<kiss_fft_state, KissFftDeleter>;
+} // namespace
+
+void normalize(std::vector<sf::Vector2f>& pts)
+{
+    if (pts.empty())
+        return;
+
+    const sf::Vector2f mean = std::accumulate(
+                                  pts.begin(),
+                                  pts.end(),
+                                  sf::Vector2f{},
+                                  [](sf::Vector2f acc, const sf::Vector2f& p)
+                                  {
+                                      acc.x += p.x;
+                                      acc.y += p.y;
+                                      return acc;
+                                  })
+                              / static_cast<float>(pts.size());
+
+    for (auto& p : pts)
+        p -= mean;
+
+    const float maxVal = std::accumulate(
+        pts.begin(),
+        pts.end(),
+        0.0f,
+        [](float m, const sf::Vector2f& p)
+        { return std::max(m, std::max(std::fabs(p.x), std::fabs(p.y))); });
+
+    if (maxVal > 0.0f)
+    {
+        for (auto& p : pts)
+            p /= maxVal;
+    }
+}
+
+void normalizeTogether(std::vector<std::vector<sf::Vector2f>>& contours)
+{
+    sf::Vector2f sum{};
+    std::size_t  count = 0;
+    for (const auto& pts : contours)
+    {
+        for (const auto& p : pts)
+            sum += p;
+        count += pts.size();
+    }
+    if (count == 0)
+        return;
+
+    const sf::Vector2f mean   = sum / static_cast<float>(count);
+    float              maxVal = 0.0f;
+    for (auto& pts : contours)
+    {
+        for (auto& p : pts)
+        {
+            p -= mean;
+            maxVal = std::max(maxVal, std::max(std::fabs(p.x), std::fabs(p.y)));
+        }
+    }
+
+    if (maxVal > 0.0f)
+    {
+        for (auto& pts : contours)
+            for (auto& p : pts)
+                p /= maxVal;
+    }
+}
+
+void shiftContourToOpposite(std::vector<sf::Vector2f>& pts)
+{
+    if (pts.size() < 2)
+        return;
+
+    const int shift = pts.size() / 2; // halfway around
+    std::rotate(pts.begin(), pts.begin() + shift, pts.end());
+}
+
+void shiftContourToBottomMiddle(std::vector<sf::Vector2f>& pts)
+{
+    if (pts.empty())
+        return;
+
+    // Step 1: Compute average X
+    float avgX =
+        std::accumulate(
+            pts.begin(), pts.end(), 0.f, [](float sum, const sf::Vector2f& p) { return sum + p.x; })
+        / static_cast<float>(pts.size());
+
+    // Step 2 & 3: Find the point closest to avgX with the lowest Y
+    int   bestIdx  = 0;
+    float bestDist = std::numeric_limits<float>::max();
+
+    for (int i = 0; i < pts.size(); ++i)
+    {
+        float xDist = std::abs(pts[i].x - avgX);
+        float yVal  = pts[i].y;
+
+        float score = xDist + yVal * 0.01f; // prioritize X, break ties with Y
+        if (score < bestDist)
+        {
+            bestDist = score;
+            bestIdx  = i;
+        }
+    }
+
+    // Step 4: Rotate to that index
+    std::rotate(pts.begin(), pts.begin() + bestIdx, pts.end());
+}
+
+bool computeFourier(const std::vector<sf::Vector2f>& pts, int numComponents, FourierData& out)
+{
+    const int N = static_cast<int>(pts.size());
+    if (N < 2)
+    {
+        std::cerr << "[KamonFourier] Not enough points for FFT.\n";
+        return false;
+    }
+
+    std::vector<kiss_fft_cpx> in(N), spectrum(N);
+    for (int i = 0; i < N; ++i)
+    {
+        in[i].r = pts[i].x;
+        in[i].i = pts[i].y;
+    }
+
+    KissFftPtr cfg{kiss_fft_alloc(N, 0, nullptr, nullptr)};
+    if (!cfg)
+    {
+        std::cerr << "[KamonFourier] KissFFT allocation failed.\n";
+        return false;
+    }
+
+    kiss_fft(cfg.get(), in.data(), spectrum.data());
+
+    const float           invN = 1.0f / static_cast<float>(N);
+    std::vector<complexf> cplx(N);
+    for (int i = 0; i < N; ++i)
+        cplx[i] = {spectrum[i].r * invN, spectrum[i].i * invN};
+
+    // Magnitude-frequency pairs, sorted by magnitude (descending)
+    struct MagIdx
+    {
+        int   freq;
+        float mag;
+    };
+    std::vector<MagIdx> magIndex;
+    magIndex.reserve(N);
+
+    for (int k = 0; k < N; ++k)
+    {
+        const int freq = (k <= N / 2) ? k : k - N;
+        magIndex.push_back({freq, std::abs(cplx[k])});
+    }
+
+    const int keep = std::min(numComponents, N);
+    std::partial_sort(
+        magIndex.begin(),
+        magIndex.begin() + keep,
+        magIndex.end(),
+        [](const MagIdx& a, const MagIdx& b) { return a.mag > b.mag; });
+
+    out.coeffs.resize(keep);
+    out.freqs.resize(keep);
+
+    for (int i = 0; i < keep; ++i)
+    {
+        const int freq = magIndex[i].freq;
+        const int idx  = (freq >= 0) ? freq : freq + N;
+
+        out.coeffs[i] = cplx[idx];
+        out.freqs[i]  = freq;
+    }
+    return true;
+}
+
+bool process(std::vector<sf::Vector2f>& pts, int numComponents, FourierData& out)
+{
+    shiftContourToBottomMiddle(pts);
+    shiftContourToOpposite(pts);
+    normalize(pts);
+    return computeFourier(pts, numComponents, out);
+}
+
+bool processAll(
+    std::vector<std::vector<sf::Vector2f>>& contours,
+    int                                     numComponents,
+    std::vector<FourierData>&               out)
+{
+    normalizeTogether(contours);
+
+    out.clear();
+    out.reserve(contours.size());
+    std::vector<std::vector<sf::Vector2f>> kept;
+    kept.reserve(contours.size());
+    for (auto& pts : contours)
+    {
+        shiftContourToBottomMiddle(pts);
+        shiftContourToOpposite(pts);
+
+        FourierData data;
+        if (!computeFourier(pts, numComponents, data))
+            continue;
+        out.push_back(std::move(data));
+        kept.push_back(std::move(pts));
+    }
+
+    contours = std::move(kept);
+    return !out.empty();
+}
+
+} // namespace KamonFourier::FourierPipeline
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <complex>
+#include <vector>
+
+namespace KamonFourier::FourierPipeline
+{
+// Strongest Fourier components of a closed contour, sorted by magnitude (descending)
+struct FourierData
+{
+    std::vector<std::complex<float>> coeffs;
+    std::vector<int>                 freqs;
+};
+
+// Normalise input points to a −1..1 range around the origin
+void normalize(std::vector<sf::Vector2f>& pts);
+
+// Normalise several contours with one shared centre and scale (keeps their relative layout)
+void normalizeTogether(std::vector<std::vector<sf::Vector2f>>& contours);
+
+// Shift the contour starting point to the opposite side
+void shiftContourToOpposite(std::vector<sf::Vector2f>& pts);
+
+// Start the contour at the point below the horizontal centre of mass
+void shiftContourToBottomMiddle(std::vector<sf::Vector2f>& pts);
+
+// Compute the `numComponents` strongest Fourier coefficients using KissFFT
+bool computeFourier(const std::vector<sf::Vector2f>& pts, int numComponents, FourierData& out);
+
+// Full pipeline as used by the KamonFourier screen: shift, normalise, FFT.
+// `pts` is modified in place and holds the normalised contour afterwards.
+bool process(std::vector<sf::Vector2f>& pts, int numComponents, FourierData& out);
+
+// Multi-contour variant: one coefficient set per contour, normalised together.
+// Contours that cannot be transformed are dropped (from `contours` as well).
+bool processAll(
+    std::vector<std::vector<sf::Vector2f>>& contours,
+    int                                     numComponents,
+    std::vector<FourierData>&               out);
+} // namespace KamonFourier::FourierPipeline
@@ -0,0 +1,301 @@
+#include "shapeIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace KamonFourier
+{
+namespace
+{
+constexpr char kMagic[4] = {'K', 'S', 'I', '1'};
+
+float squaredDistance(const Descriptor& a, const Descriptor& b)
+{
+    float sum = 0.f;
+    for (int i = 0; i < kDescriptorSize; ++i)
+    {
+        const float d = a[i] - b[i];
+        sum += d * d;
+    }
+    return sum;
+}
+
+template <typename T>
+void writePod(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::ifstream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+} // namespace
+
+Descriptor makeDescriptor(const FourierPipeline::FourierData& fourier)
+{
+    // |c_k| for k = -H..H (k = 0 stays unused)
+    std::array<float, 2 * kDescriptorHarmonics + 1> mag{};
+    for (std::size_t i = 0; i < fourier.coeffs.size(); ++i)
+    {
+        const int freq = fourier.freqs[i];
+        if (freq != 0 && std::abs(freq) <= kDescriptorHarmonics)
+            mag[freq + kDescriptorHarmonics] = std::abs(fourier.coeffs[i]);
+    }
+
+    // Mirror clockwise contours so the dominant first harmonic is always +1
+    const float pos1   = mag[kDescriptorHarmonics + 1];
+    const float neg1   = mag[kDescriptorHarmonics - 1];
+    const bool  mirror = neg1 > pos1;
+    const float scale  = std::max(pos1, neg1);
+
+    Descriptor desc{};
+    if (scale <= 0.f)
+        return desc;
+
+    for (int k = 1; k <= kDescriptorHarmonics; ++k)
+    {
+        const float p = mag[kDescriptorHarmonics + k] / scale;
+        const float n = mag[kDescriptorHarmonics - k] / scale;
+
+        desc[2 * (k - 1)]     = mirror ? n : p;
+        desc[2 * (k - 1) + 1] = mirror ? p : n;
+    }
+    return desc;
+}
+
+void ShapeIndex::add(std::string name, const Descriptor& descriptor)
+{
+    m_names.push_back(std::move(name));
+    m_points.push_back(descriptor);
+}
+
+void ShapeIndex::build()
+{
+    m_nodes.clear();
+    m_nodes.reserve(m_points.size());
+
+    std::vector<std::uint32_t> ids(m_points.size());
+    std::iota(ids.begin(), ids.end(), 0u);
+    m_root = buildRecursive(ids, 0, ids.size());
+}
+
+std::int32_t ShapeIndex::buildRecursive(
+    std::vector<std::uint32_t>& ids, std::size_t lo, std::size_t hi)
+{
+    if (lo >= hi)
+        return -1;
+
+    // Split along the axis with the largest spread
+    std::uint32_t axis       = 0;
+    float         bestSpread = -1.f;
+    for (int d = 0; d < kDescriptorSize; ++d)
+    {
+        float minV = std::numeric_limits<float>::max();
+        float maxV = std::numeric_limits<float>::lowest();
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            minV = std::min(minV, m_points[ids[i]][d]);
+            maxV = std::max(maxV, m_points[ids[i]][d]);
+        }
+        if (maxV - minV > bestSpread)
+        {
+            bestSpread = maxV - minV;
+            axis       = static_cast<std::uint32_t>(d);
+        }
+    }
+
+    const std::size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(
+        ids.begin() + lo,
+        ids.begin() + mid,
+        ids.begin() + hi,
+        [&](std::uint32_t a, std::uint32_t b) { return m_points[a][axis] < m_points[b][axis]; });
+
+    const auto nodeIdx = static_cast<std::int32_t>(m_nodes.size());
+    m_nodes.push_back({ids[mid], -1, -1, axis});
+
+    const std::int32_t left  = buildRecursive(ids, lo, mid);
+    const std::int32_t right = buildRecursive(ids, mid + 1, hi);
+    m_nodes[nodeIdx].left    = left;
+    m_nodes[nodeIdx].right   = right;
+    return nodeIdx;
+}
+
+std::vector<ShapeIndex::Match> ShapeIndex::query(const Descriptor& descriptor, std::size_t k) const
+{
+    if (m_root < 0 || k == 0)
+        return {};
+
+    // Max-heap of the k best candidates found so far (squared distance, point)
+    using Candidate = std::pair<float, std::uint32_t>;
+    std::priority_queue<Candidate> best;
+
+    // Depth-first descent, nearer side first; far sides are visited only if the
+    // splitting plane is closer than the current k-th best.
+    auto search = [&](auto&& self, std::int32_t nodeIdx) -> void
+    {
+        if (nodeIdx < 0)
+            return;
+
+        const Node& node = m_nodes[nodeIdx];
+        const float dist = squaredDistance(descriptor, m_points[node.point]);
+        if (best.size() < k)
+            best.emplace(dist, node.point);
+        else if (dist < best.top().first)
+        {
+            best.pop();
+            best.emplace(dist, node.point);
+        }
+
+        const float delta = descriptor[node.axis] - m_points[node.point][node.axis];
+        const auto  near  = delta < 0.f ? node.left : node.right;
+        const auto  far   = delta < 0.f ? node.right : node.left;
+
+        self(self, near);
+        if (best.size() < k || delta * delta < best.top().first)
+            self(self, far);
+    };
+    search(search, m_root);
+
+    std::vector<Match> result(best.size());
+    for (std::size_t i = result.size(); i-- > 0;)
+    {
+        result[i] = {m_names[best.top().second], std::sqrt(best.top().first)};
+        best.pop();
+    }
+    return result;
+}
+
+bool ShapeIndex::save(const std::string& filename) const
+{
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cerr << "[KamonFourier] Failed to open file: " << filename << '\n';
+        return false;
+    }
+
+    out.write(kMagic, sizeof(kMagic));
+    writePod(out, static_cast<std::uint32_t>(kDescriptorSize));
+    writePod(out, static_cast<std::uint32_t>(m_points.size()));
+    writePod(out, m_root);
+
+    for (std::size_t i = 0; i < m_points.size(); ++i)
+    {
+        writePod(out, static_cast<std::uint16_t>(m_names[i].size()));
+        out.write(m_names[i].data(), static_cast<std::streamsize>(m_names[i].size()));
+        out.write(reinterpret_cast<const char*>(m_points[i].data()), sizeof(Descriptor));
+    }
+
+    writePod(out, static_cast<std::uint32_t>(m_nodes.size()));
+    out.write(
+        reinterpret_cast<const char*>(m_nodes.data()),
+        static_cast<std::streamsize>(m_nodes.size() * sizeof(Node)));
+
+    return static_cast<bool>(out);
+}
+
+bool ShapeIndex::validTree(const std::vector<Node>& nodes, std::int32_t root)
+{
+    const auto count = static_cast<std::int64_t>(nodes.size());
+    if (root < -1 || root >= count || (count > 0 && root < 0))
+        return false;
+
+    // Reachable nodes form a tree if none is the child of two nodes or the root's parent
+    std::vector<std::uint8_t> parents(nodes.size(), 0);
+    if (root >= 0)
+        parents[root] = 1;
+    for (const Node& node : nodes)
+    {
+        if (node.point >= nodes.size() || node.axis >= kDescriptorSize)
+            return false;
+        for (const std::int32_t child : {node.left, node.right})
+        {
+            if (child < -1 || child >= count)
+                return false;
+            if (child >= 0 && parents[child]++ != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool ShapeIndex::load(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cerr << "[KamonFourier] Failed to open shape index: " << filename << '\n';
+        return false;
+    }
+
+    in.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::size_t>(std::max<std::streamoff>(in.tellg(), 0));
+    in.seekg(0, std::ios::beg);
+
+    char          magic[4] = {};
+    std::uint32_t dims = 0, count = 0, nodeCount = 0;
+    std::int32_t  root = -1;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, kMagic)
+        || !readPod(in, dims) || dims != kDescriptorSize || !readPod(in, count)
+        || !readPod(in, root))
+    {
+        std::cerr << "[KamonFourier] Incompatible shape index: " << filename << '\n';
+        return false;
+    }
+    // Each shape takes at least a name length, its descriptor and its node
+    constexpr std::size_t kMinShapeBytes =
+        sizeof(std::uint16_t) + sizeof(Descriptor) + sizeof(Node);
+    if (count > fileSize / kMinShapeBytes)
+    {
+        std::cerr << "[KamonFourier] Truncated shape index: " << filename << '\n';
+        return false;
+    }
+
+    std::vector<std::string> names(count);
+    std::vector<Descriptor>  points(count);
+    for (std::uint32_t i = 0; i < count && in; ++i)
+    {
+        std::uint16_t len = 0;
+        readPod(in, len);
+        names[i].resize(len);
+        in.read(names[i].data(), len);
+        in.read(reinterpret_cast<char*>(points[i].data()), sizeof(Descriptor));
+    }
+
+    std::vector<Node> nodes;
+    if (readPod(in, nodeCount) && nodeCount == count)
+    {
+        nodes.resize(nodeCount);
+        in.read(
+            reinterpret_cast<char*>(nodes.data()),
+            static_cast<std::streamsize>(nodes.size() * sizeof(Node)));
+    }
+
+    if (!in || nodes.size() != count)
+    {
+        std::cerr << "[KamonFourier] Truncated shape index: " << filename << '\n';
+        return false;
+    }
+    if (!validTree(nodes, root))
+    {
+        std::cerr << "[KamonFourier] Corrupt shape index: " << filename << '\n';
+        return false;
+    }
+
+    m_names  = std::move(names);
+    m_points = std::move(points);
+    m_nodes  = std::move(nodes);
+    m_root   = root;
+    return true;
+}
+
+} // namespace KamonFourier
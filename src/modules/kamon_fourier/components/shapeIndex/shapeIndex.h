@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../fourierPipeline/fourierPipeline.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KamonFourier
+{
+// Harmonics ±1..±kDescriptorHarmonics make up one shape descriptor
+constexpr int kDescriptorHarmonics = 8;
+constexpr int kDescriptorSize      = 2 * kDescriptorHarmonics;
+
+using Descriptor = std::array<float, kDescriptorSize>;
+
+/**
+ * @brief Rotation-, scale- and start-point-invariant descriptor of a contour.
+ *
+ * Uses |c_k| / |c_1| for k = ±1..±kDescriptorHarmonics. Magnitudes drop rotation and the
+ * start point (both only change the phase), dividing by the first harmonic drops scale and
+ * the DC term (translation) is ignored. Contours traced clockwise are mirrored so that the
+ * dominant harmonic is always +1. Harmonics missing from `fourier` count as zero, so index
+ * and query should be computed with the same number of components.
+ */
+Descriptor makeDescriptor(const FourierPipeline::FourierData& fourier);
+
+/**
+ * @brief In-memory k-d tree over shape descriptors with top-k nearest-neighbour queries.
+ *
+ * Usage: add() all shapes, build() once, then query(). The built tree can be persisted with
+ * save() and restored with load() without rebuilding.
+ */
+class ShapeIndex
+{
+  public:
+    struct Match
+    {
+        std::string name;
+        float       distance; // Euclidean distance in descriptor space
+    };
+
+    void add(std::string name, const Descriptor& descriptor);
+
+    /** Build the k-d tree over everything added so far. */
+    void build();
+
+    /** The k closest shapes, nearest first. Requires build() or load(). */
+    std::vector<Match> query(const Descriptor& descriptor, std::size_t k) const;
+
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+
+    std::size_t size() const
+    {
+        return m_points.size();
+    }
+
+  private:
+    struct Node
+    {
+        std::uint32_t point; // index into m_points / m_names
+        std::int32_t  left;  // -1 = none
+        std::int32_t  right; // -1 = none
+        std::uint32_t axis;
+    };
+
+    std::int32_t buildRecursive(std::vector<std::uint32_t>& ids, std::size_t lo, std::size_t hi);
+
+    // Every index in range and the nodes reachable from `root` form a tree, so query() stays
+    // in bounds and terminates on whatever load() read
+    static bool validTree(const std::vector<Node>& nodes, std::int32_t root);
+
+    std::vector<std::string> m_names;
+    std::vector<Descriptor>  m_points;
+    std::vector<Node>        m_nodes;
+    std::int32_t             m_root{-1};
+};
+} // namespace KamonFourier
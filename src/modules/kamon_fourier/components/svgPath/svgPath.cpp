@@ -0,0 +1,550 @@
+#include "svgPath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace KamonFourier::SvgPath
+{
+namespace
+{
+constexpr float PI        = 3.14159265358979323846f;
+constexpr int   MAX_DEPTH = 16; // at most 2^16 points per Bézier segment
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isSeparator(char c)
+{
+    return c == ' ' || c == ',' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+bool isCommand(char c)
+{
+    switch (c)
+    {
+    case 'M':
+    case 'm':
+    case 'L':
+    case 'l':
+    case 'H':
+    case 'h':
+    case 'V':
+    case 'v':
+    case 'C':
+    case 'c':
+    case 'S':
+    case 's':
+    case 'Q':
+    case 'q':
+    case 'T':
+    case 't':
+    case 'A':
+    case 'a':
+    case 'Z':
+    case 'z':
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Allocation-free tokenizer over the path data
+// ──────────────────────────────────────────────────────────────────────────────
+class Cursor
+{
+  public:
+    explicit Cursor(std::string_view d) : m_p(d.data()), m_end(d.data() + d.size()) {}
+
+    void skipSeparators()
+    {
+        while (m_p < m_end && isSeparator(*m_p))
+            ++m_p;
+    }
+
+    bool done()
+    {
+        skipSeparators();
+        return m_p >= m_end;
+    }
+
+    // Next token is a command letter → consume and return it, otherwise 0
+    char command()
+    {
+        skipSeparators();
+        if (m_p < m_end && isCommand(*m_p))
+            return *m_p++;
+        return 0;
+    }
+
+    // SVG number: [sign] digits [. digits] [e [sign] digits]. "1.5.5" and "1-2" are two
+    // numbers each, as the grammar requires.
+    bool number(float& value)
+    {
+        skipSeparators();
+        const char* p   = m_p;
+        bool        neg = false;
+        if (p < m_end && (*p == '+' || *p == '-'))
+            neg = *p++ == '-';
+
+        double mantissa = 0.0;
+        int    exponent = 0;
+        int    digits   = 0;
+        while (p < m_end && isDigit(*p))
+        {
+            mantissa = mantissa * 10.0 + (*p++ - '0');
+            ++digits;
+        }
+        if (p < m_end && *p == '.')
+        {
+            ++p;
+            while (p < m_end && isDigit(*p))
+            {
+                mantissa = mantissa * 10.0 + (*p++ - '0');
+                --exponent;
+                ++digits;
+            }
+        }
+        if (digits == 0)
+            return false;
+
+        if (p < m_end && (*p == 'e' || *p == 'E'))
+        {
+            const char* e      = p + 1;
+            bool        expNeg = false;
+            if (e < m_end && (*e == '+' || *e == '-'))
+                expNeg = *e++ == '-';
+            if (e < m_end && isDigit(*e))
+            {
+                int exp = 0;
+                while (e < m_end && isDigit(*e))
+                    exp = std::min(exp * 10 + (*e++ - '0'), 999);
+                exponent += expNeg ? -exp : exp;
+                p = e;
+            }
+        }
+
+        const double v = exponent == 0 ? mantissa : mantissa * std::pow(10.0, exponent);
+        value          = static_cast<float>(neg ? -v : v);
+        m_p            = p;
+        return true;
+    }
+
+    // Arc flags are single characters and may be written without separators ("a1 1 0 00 5 5")
+    bool flag(bool& value)
+    {
+        skipSeparators();
+        if (m_p < m_end && (*m_p == '0' || *m_p == '1'))
+        {
+            value = *m_p++ == '1';
+            return true;
+        }
+        return false;
+    }
+
+    bool point(sf::Vector2f& p)
+    {
+        return number(p.x) && number(p.y);
+    }
+
+  private:
+    const char* m_p;
+    const char* m_end;
+};
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Writes flattened geometry into Subpaths
+// ──────────────────────────────────────────────────────────────────────────────
+class Flattener
+{
+  public:
+    Flattener(Subpaths& out, float tolerance)
+        : m_out(out), m_tolSq(std::max(tolerance, 1e-4f) * std::max(tolerance, 1e-4f))
+    {
+    }
+
+    void moveTo(sf::Vector2f p)
+    {
+        finishSubpath();
+        m_out.starts.push_back(m_out.points.size());
+        m_out.points.push_back(p);
+        m_open = true;
+    }
+
+    // A drawing command right after Z continues from the closed subpath's start point
+    void ensureOpen(sf::Vector2f current)
+    {
+        if (!m_open)
+            moveTo(current);
+    }
+
+    void lineTo(sf::Vector2f p)
+    {
+        m_out.points.push_back(p);
+    }
+
+    void cubicTo(sf::Vector2f p0, sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3)
+    {
+        flattenCubic(p0, p1, p2, p3, 0);
+    }
+
+    void quadTo(sf::Vector2f p0, sf::Vector2f q, sf::Vector2f p)
+    {
+        // Degree elevation: a quadratic is a cubic with controls at 2/3 towards q
+        constexpr float k = 2.f / 3.f;
+        flattenCubic(p0, p0 + (q - p0) * k, p + (q - p) * k, p, 0);
+    }
+
+    void arcTo(
+        sf::Vector2f p0,
+        float        rx,
+        float        ry,
+        float        rotationDeg,
+        bool         largeArc,
+        bool         sweep,
+        sf::Vector2f p);
+
+    void close()
+    {
+        if (!m_open)
+            return;
+        const sf::Vector2f first = m_out.points[m_out.starts.back()];
+        const sf::Vector2f last  = m_out.points.back();
+        if (first.x != last.x || first.y != last.y)
+            m_out.points.push_back(first);
+        m_open = false;
+    }
+
+    // Drop the current subpath if it is degenerate
+    void finishSubpath()
+    {
+        if (!m_out.starts.empty() && m_out.points.size() - m_out.starts.back() < 2)
+        {
+            m_out.points.resize(m_out.starts.back());
+            m_out.starts.pop_back();
+        }
+        m_open = false;
+    }
+
+  private:
+    void flattenCubic(sf::Vector2f p0, sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3, int depth)
+    {
+        if (depth >= MAX_DEPTH || isFlat(p0, p1, p2, p3))
+        {
+            m_out.points.push_back(p3);
+            return;
+        }
+
+        // de Casteljau split at t = 0.5
+        const sf::Vector2f p01  = (p0 + p1) * 0.5f;
+        const sf::Vector2f p12  = (p1 + p2) * 0.5f;
+        const sf::Vector2f p23  = (p2 + p3) * 0.5f;
+        const sf::Vector2f p012 = (p01 + p12) * 0.5f;
+        const sf::Vector2f p123 = (p12 + p23) * 0.5f;
+        const sf::Vector2f mid  = (p012 + p123) * 0.5f;
+
+        flattenCubic(p0, p01, p012, mid, depth + 1);
+        flattenCubic(mid, p123, p23, p3, depth + 1);
+    }
+
+    // Both control points within tolerance of the chord → flat enough, since the curve
+    // lies in the convex hull of its control points
+    bool isFlat(sf::Vector2f p0, sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3) const
+    {
+        const sf::Vector2f chord = p3 - p0;
+        const float        lenSq = chord.x * chord.x + chord.y * chord.y;
+
+        auto distSq = [&](sf::Vector2f c)
+        {
+            const sf::Vector2f v = c - p0;
+            if (lenSq < 1e-12f)
+                return v.x * v.x + v.y * v.y;
+            const float cross = v.x * chord.y - v.y * chord.x;
+            return cross * cross / lenSq;
+        };
+        return distSq(p1) <= m_tolSq && distSq(p2) <= m_tolSq;
+    }
+
+    Subpaths& m_out;
+    float     m_tolSq;
+    bool      m_open{false};
+};
+
+void Flattener::arcTo(
+    sf::Vector2f p0,
+    float        rx,
+    float        ry,
+    float        rotationDeg,
+    bool         largeArc,
+    bool         sweep,
+    sf::Vector2f p)
+{
+    if (p0.x == p.x && p0.y == p.y)
+        return;
+
+    rx = std::fabs(rx);
+    ry = std::fabs(ry);
+    if (rx == 0.f || ry == 0.f)
+    {
+        lineTo(p);
+        return;
+    }
+
+    // Endpoint → centre parameterisation (SVG 1.1, appendix F.6.5)
+    const float phi  = rotationDeg * PI / 180.f;
+    const float cphi = std::cos(phi);
+    const float sphi = std::sin(phi);
+
+    const float dx2 = (p0.x - p.x) * 0.5f;
+    const float dy2 = (p0.y - p.y) * 0.5f;
+    const float x1p = cphi * dx2 + sphi * dy2;
+    const float y1p = -sphi * dx2 + cphi * dy2;
+
+    const float lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+    if (lambda > 1.f)
+    {
+        rx *= std::sqrt(lambda);
+        ry *= std::sqrt(lambda);
+    }
+
+    const float rx2  = rx * rx;
+    const float ry2  = ry * ry;
+    const float num  = rx2 * ry2 - rx2 * y1p * y1p - ry2 * x1p * x1p;
+    const float den  = rx2 * y1p * y1p + ry2 * x1p * x1p;
+    const float coef = (largeArc == sweep ? -1.f : 1.f) * std::sqrt(std::max(0.f, num / den));
+
+    const float cxp = coef * rx * y1p / ry;
+    const float cyp = -coef * ry * x1p / rx;
+    const float cx  = cphi * cxp - sphi * cyp + (p0.x + p.x) * 0.5f;
+    const float cy  = sphi * cxp + cphi * cyp + (p0.y + p.y) * 0.5f;
+
+    auto angle = [](float ux, float uy, float vx, float vy)
+    { return std::atan2(ux * vy - uy * vx, ux * vx + uy * vy); };
+
+    const float theta1 = angle(1.f, 0.f, (x1p - cxp) / rx, (y1p - cyp) / ry);
+    float dTheta = angle((x1p - cxp) / rx, (y1p - cyp) / ry, (-x1p - cxp) / rx, (-y1p - cyp) / ry);
+    if (!sweep && dTheta > 0.f)
+        dTheta -= 2.f * PI;
+    else if (sweep && dTheta < 0.f)
+        dTheta += 2.f * PI;
+
+    // Split into ≤ 90° pieces, each approximated by one cubic
+    const int   segments = std::max(1, static_cast<int>(std::ceil(std::fabs(dTheta) / (PI / 2.f))));
+    const float delta    = dTheta / static_cast<float>(segments);
+    const float k        = 4.f / 3.f * std::tan(delta / 4.f);
+
+    auto pointAt = [&](float t)
+    {
+        const float ct = std::cos(t), st = std::sin(t);
+        return sf::Vector2f(
+            cx + rx * ct * cphi - ry * st * sphi, cy + rx * ct * sphi + ry * st * cphi);
+    };
+    auto derivAt = [&](float t)
+    {
+        const float ct = std::cos(t), st = std::sin(t);
+        return sf::Vector2f(-rx * st * cphi - ry * ct * sphi, -rx * st * sphi + ry * ct * cphi);
+    };
+
+    sf::Vector2f from = p0;
+    for (int i = 0; i < segments; ++i)
+    {
+        const float        t1 = theta1 + delta * static_cast<float>(i);
+        const float        t2 = t1 + delta;
+        const sf::Vector2f to = (i + 1 == segments) ? p : pointAt(t2);
+        cubicTo(from, from + derivAt(t1) * k, to - derivAt(t2) * k, to);
+        from = to;
+    }
+}
+} // namespace
+
+bool parse(std::string_view d, float tolerance, Subpaths& out)
+{
+    Cursor    cur(d);
+    Flattener flat(out, tolerance);
+
+    sf::Vector2f pos(0.f, 0.f);   // current point
+    sf::Vector2f start(0.f, 0.f); // start of the current subpath
+    sf::Vector2f ctrl(0.f, 0.f);  // last control point (for S / T reflection)
+    char         cmd    = 0;      // current command (persists for implicit repeats)
+    char         prevOp = 0;
+    bool         ok     = true;
+
+    while (!cur.done())
+    {
+        if (const char c = cur.command())
+            cmd = c;
+        else if (!cmd || cmd == 'Z' || cmd == 'z')
+        {
+            ok = false; // coordinates without a command
+            break;
+        }
+
+        const bool         relative = cmd >= 'a';
+        const char         op       = static_cast<char>(relative ? cmd - ('a' - 'A') : cmd);
+        const sf::Vector2f base     = relative ? pos : sf::Vector2f(0.f, 0.f);
+
+        if (op != 'M' && op != 'Z')
+            flat.ensureOpen(pos);
+
+        bool good = true;
+        switch (op)
+        {
+        case 'M':
+        {
+            sf::Vector2f p;
+            if (!(good = cur.point(p)))
+                break;
+            pos = start = p + base;
+            flat.moveTo(pos);
+            cmd = relative ? 'l' : 'L'; // further pairs are implicit line-tos
+            break;
+        }
+        case 'L':
+        {
+            sf::Vector2f p;
+            if (!(good = cur.point(p)))
+                break;
+            pos = p + base;
+            flat.lineTo(pos);
+            break;
+        }
+        case 'H':
+        {
+            float x;
+            if (!(good = cur.number(x)))
+                break;
+            pos.x = x + base.x;
+            flat.lineTo(pos);
+            break;
+        }
+        case 'V':
+        {
+            float y;
+            if (!(good = cur.number(y)))
+                break;
+            pos.y = y + base.y;
+            flat.lineTo(pos);
+            break;
+        }
+        case 'C':
+        case 'S':
+        {
+            sf::Vector2f c1, c2, p;
+            if (op == 'C')
+                good = cur.point(c1) && cur.point(c2) && cur.point(p);
+            else
+                good = cur.point(c2) && cur.point(p);
+            if (!good)
+                break;
+
+            if (op == 'C')
+                c1 += base;
+            else
+                c1 = (prevOp == 'C' || prevOp == 'S') ? pos * 2.f - ctrl : pos;
+            c2 += base;
+            p += base;
+
+            flat.cubicTo(pos, c1, c2, p);
+            ctrl = c2;
+            pos  = p;
+            break;
+        }
+        case 'Q':
+        case 'T':
+        {
+            sf::Vector2f q, p;
+            if (op == 'Q')
+                good = cur.point(q) && cur.point(p);
+            else
+                good = cur.point(p);
+            if (!good)
+                break;
+
+            if (op == 'Q')
+                q += base;
+            else
+                q = (prevOp == 'Q' || prevOp == 'T') ? pos * 2.f - ctrl : pos;
+            p += base;
+
+            flat.quadTo(pos, q, p);
+            ctrl = q;
+            pos  = p;
+            break;
+        }
+        case 'A':
+        {
+            float        rx, ry, rot;
+            bool         largeArc, sweep;
+            sf::Vector2f p;
+            good = cur.number(rx) && cur.number(ry) && cur.number(rot) && cur.flag(largeArc)
+                   && cur.flag(sweep) && cur.point(p);
+            if (!good)
+                break;
+
+            p += base;
+            flat.arcTo(pos, rx, ry, rot, largeArc, sweep, p);
+            pos = p;
+            break;
+        }
+        case 'Z':
+            flat.close();
+            pos = start;
+            break;
+        }
+
+        if (!good)
+        {
+            ok = false;
+            break;
+        }
+        prevOp = op;
+    }
+
+    flat.finishSubpath();
+    return ok;
+}
+
+std::string_view nextPathData(std::string_view svg, std::size_t& pos)
+{
+    while (true)
+    {
+        const std::size_t tag = svg.find("<path", pos);
+        if (tag == std::string_view::npos)
+        {
+            pos = svg.size();
+            return {};
+        }
+
+        const std::size_t tagEnd = svg.find('>', tag);
+        const std::size_t limit  = tagEnd == std::string_view::npos ? svg.size() : tagEnd;
+
+        // Look for a standalone "d=" attribute (not "id=" etc.)
+        std::size_t attr = tag + 5;
+        while ((attr = svg.find("d=", attr)) != std::string_view::npos && attr < limit)
+        {
+            if (isSeparator(svg[attr - 1]))
+                break;
+            attr += 2;
+        }
+
+        pos = limit;
+        if (attr == std::string_view::npos || attr >= limit)
+            continue;
+
+        const std::size_t open = attr + 2;
+        if (open >= svg.size() || (svg[open] != '"' && svg[open] != '\''))
+            continue;
+
+        const std::size_t close = svg.find(svg[open], open + 1);
+        if (close == std::string_view::npos)
+        {
+            pos = svg.size();
+            return {};
+        }
+        return svg.substr(open + 1, close - open - 1);
+    }
+}
+
+} // namespace KamonFourier::SvgPath
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace KamonFourier::SvgPath
+{
+// Flattened subpaths of one or more `d` attributes, stored back to back
+struct Subpaths
+{
+    std::vector<sf::Vector2f> points;
+    std::vector<std::size_t>  starts; // first point of each subpath
+
+    std::size_t count() const
+    {
+        return starts.size();
+    }
+
+    std::span<const sf::Vector2f> subpath(std::size_t i) const
+    {
+        const std::size_t end = i + 1 < starts.size() ? starts[i + 1] : points.size();
+        return {points.data() + starts[i], end - starts[i]};
+    }
+
+    void clear()
+    {
+        points.clear();
+        starts.clear();
+    }
+};
+
+/**
+ * @brief Parse and flatten SVG path data (full grammar: M L H V C S Q T A Z, absolute and
+ * relative, implicit repeats, multiple subpaths).
+ *
+ * Curves are flattened adaptively: a Bézier segment is subdivided until its control points
+ * lie within `tolerance` (in path units) of the chord, so the point count follows the
+ * geometry instead of a fixed number of samples per curve. Arcs are converted to cubics.
+ * Subpaths are appended to `out`; subpaths with fewer than two points are dropped.
+ *
+ * @return false if the data is malformed (everything parsed up to the error is kept).
+ */
+bool parse(std::string_view d, float tolerance, Subpaths& out);
+
+/**
+ * @brief Find the next `<path … d="…">` in an SVG document.
+ *
+ * @param svg  Whole SVG document.
+ * @param pos  Search start; advanced past the returned attribute.
+ * @return The raw `d` attribute value, or an empty view if there is no further path.
+ */
+std::string_view nextPathData(std::string_view svg, std::size_t& pos);
+} // namespace KamonFourier::SvgPath
@@ -1,5 +1,6 @@
 #include "visualizer.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace KamonFourier
@@ -13,40 +14,63 @@ constexpr float DRAW_SCALE = 0.45f; // 1.0 = 100 %, 0.6 = 60 %
 Visualizer::Visualizer(int numComponents, float speed)
     : m_speed(speed), m_time(0.f), m_numComponents(numComponents)
 {
-    m_path.reserve(2000);
-    m_bgLoaded = loadBackground("assets/img/niwa.png");
+    m_unitCircle.resize(CLOCK_SEGMENTS);
+    for (std::size_t s = 0; s < CLOCK_SEGMENTS; ++s)
+    {
+        const float a   = TWO_PI * static_cast<float>(s) / static_cast<float>(CLOCK_SEGMENTS);
+        m_unitCircle[s] = {std::cos(a), std::sin(a)};
+    }
 }
 
-bool Visualizer::loadBackground(const std::string& filename)
+bool Visualizer::setBackground(const sf::Texture& texture, const sf::IntRect& rect)
 {
-    if (!m_bgTexture.loadFromFile(filename))
+    m_bgLoaded = false;
+    if (rect.size.x <= 0 || rect.size.y <= 0)
         return false;
 
-    m_bgSprite.emplace(m_bgTexture);
-
     // Scale to cover the window once we know its size (≈ first frame).
-    // A single scalar keeps the aspect ratio.
-    const sf::Vector2u texSize = m_bgTexture.getSize();
-    if (texSize.x == 0 || texSize.y == 0)
-        return false;
-
-    // Will be re-evaluated in updateAndDraw() if the window is resized.
+    // A single scalar keeps the aspect ratio; re-evaluated in updateAndDraw().
+    m_bgSprite.emplace(texture, rect);
+    m_bgLoaded = true;
     return true;
 }
 
 void Visualizer::reset()
 {
-    m_time = 0.f;
-    m_path.clear();
+    m_time      = 0.f;
+    m_trailHead = 0;
+    m_trailSize = 0;
 }
 
-void Visualizer::updateAndDraw(
-    sf::RenderWindow&                       window,
-    const std::vector<std::complex<float>>& coeffs,
-    const std::vector<int>&                 freqs)
+void Visualizer::setChains(const std::vector<FourierPipeline::FourierData>& chains)
+{
+    m_termRe.clear();
+    m_termIm.clear();
+    m_termFreq.clear();
+    m_chainStart.assign(1, 0u);
+
+    for (const auto& chain : chains)
+    {
+        for (std::size_t i = 0; i < chain.coeffs.size(); ++i)
+        {
+            m_termRe.push_back(chain.coeffs[i].real());
+            m_termIm.push_back(chain.coeffs[i].imag());
+            m_termFreq.push_back(static_cast<float>(chain.freqs[i]));
+        }
+        m_chainStart.push_back(static_cast<std::uint32_t>(m_termRe.size()));
+    }
+
+    m_rotRe.resize(m_termRe.size());
+    m_rotIm.resize(m_termRe.size());
+    m_trail.assign(chains.size() * TRAIL_LENGTH, sf::Vector2f{});
+    m_clockRadii.clear(); // force a clockwork rebuild
+    reset();
+}
+
+void Visualizer::updateAndDraw(sf::RenderWindow& window)
 {
     // Defensive checks -------------------------------------------------------
-    if (coeffs.empty() || freqs.empty() || coeffs.size() < static_cast<size_t>(m_numComponents))
+    if (m_chainStart.size() < 2 || m_termRe.empty())
         return;
 
     // 1) Advance time ---------------------------------------------------------
@@ -59,7 +83,7 @@ void Visualizer::updateAndDraw(
 
         // 1) automatic cover-window scaling
         const sf::Vector2u win = window.getSize();
-        const sf::Vector2u tex = m_bgTexture.getSize();
+        const sf::Vector2i tex = sprite.getTextureRect().size;
         float              cover =
             std::max(static_cast<float>(win.x) / tex.x, static_cast<float>(win.y) / tex.y);
 
@@ -73,64 +97,114 @@ void Visualizer::updateAndDraw(
         window.draw(sprite);
     }
 
-    // 2) MAIN EPICYCLE DRAWING ------------------------------------------------
-    std::complex<float> sumPrev(0.f, 0.f);
+    // 2) MAIN EPICYCLE EVALUATION (all chains) --------------------------------
+    evaluateChains();
+
+    // 3) Traced paths + tip dots ----------------------------------------------
+    drawTrails(window);
 
-    for (int i = 0; i < m_numComponents; ++i)
+    // 4) Clockwork ------------------------------------------------------------
+    drawClockwork(window);
+}
+
+void Visualizer::evaluateChains()
+{
+    // One flat pass over every term of every chain; no dependencies between
+    // iterations, so the compiler can vectorise it.
+    const std::size_t numTerms = m_termRe.size();
+    const float       t        = m_time;
+    for (std::size_t i = 0; i < numTerms; ++i)
     {
-        const float freq   = static_cast<float>(freqs[i]);
-        const auto& c      = coeffs[i];
-        const float radius = std::abs(c);
-        const float theta  = freq * m_time;
-
-        const std::complex<float> sumCur =
-            sumPrev
-            + std::complex<float>(
-                c.real() * std::cos(theta) - c.imag() * std::sin(theta),
-                c.real() * std::sin(theta) + c.imag() * std::cos(theta));
-
-        sumPrev = sumCur;
+        const float theta = m_termFreq[i] * t;
+        const float c     = std::cos(theta);
+        const float s     = std::sin(theta);
+        m_rotRe[i]        = m_termRe[i] * c - m_termIm[i] * s;
+        m_rotIm[i]        = m_termRe[i] * s + m_termIm[i] * c;
     }
 
-    // ---------- traced path ----------
     const sf::Vector2f screenCenter(450.f, 350.f);
+    const std::size_t  numChains = m_chainStart.size() - 1;
+    for (std::size_t chain = 0; chain < numChains; ++chain)
+    {
+        float sumRe = 0.f, sumIm = 0.f;
+        for (std::uint32_t i = m_chainStart[chain]; i < m_chainStart[chain + 1]; ++i)
+        {
+            sumRe += m_rotRe[i];
+            sumIm += m_rotIm[i];
+        }
 
-    const sf::Vector2f tipPos(
-        screenCenter.x + sumPrev.real() * 200.f * DRAW_SCALE,
-        screenCenter.y - sumPrev.imag() * 200.f * DRAW_SCALE);
+        m_trail[chain * TRAIL_LENGTH + m_trailHead] = {
+            screenCenter.x + sumRe * 200.f * DRAW_SCALE,
+            screenCenter.y - sumIm * 200.f * DRAW_SCALE};
+    }
 
-    m_path.push_back(tipPos);
-    if (m_path.size() > 2000)
-        m_path.erase(m_path.begin());
+    m_trailHead = (m_trailHead + 1) % TRAIL_LENGTH;
+    m_trailSize = std::min(m_trailSize + 1, TRAIL_LENGTH);
+}
+
+void Visualizer::drawTrails(sf::RenderWindow& window)
+{
+    const std::size_t numChains = m_chainStart.size() - 1;
+    const std::size_t oldest    = (m_trailHead + TRAIL_LENGTH - m_trailSize) % TRAIL_LENGTH;
+    const std::size_t newest    = (m_trailHead + TRAIL_LENGTH - 1) % TRAIL_LENGTH;
+
+    // ---------- traced paths: every chain in one line batch ----------
+    const std::size_t segments = m_trailSize > 0 ? m_trailSize - 1 : 0;
+    m_trailLines.setPrimitiveType(sf::PrimitiveType::Lines);
+    m_trailLines.resize(numChains * segments * 2);
 
-    sf::VertexArray pathLines(sf::PrimitiveType::LineStrip, m_path.size());
-    for (size_t i = 0; i < m_path.size(); ++i)
+    std::size_t v = 0;
+    for (std::size_t chain = 0; chain < numChains; ++chain)
     {
-        pathLines[i].position = m_path[i];
-        pathLines[i].color    = sf::Color::Black;
+        const sf::Vector2f* ring = &m_trail[chain * TRAIL_LENGTH];
+        for (std::size_t k = 0; k < segments; ++k)
+        {
+            m_trailLines[v++] = {ring[(oldest + k) % TRAIL_LENGTH], sf::Color::Black};
+            m_trailLines[v++] = {ring[(oldest + k + 1) % TRAIL_LENGTH], sf::Color::Black};
+        }
     }
-    window.draw(pathLines);
+    window.draw(m_trailLines);
 
-    // ---------- red dot ----------
-    sf::CircleShape dot(4.f); // 4-pixel-radius filled circle
-    dot.setOrigin({4.f, 4.f});
-    dot.setFillColor(sf::Color::Red);
-    dot.setPosition(tipPos);
-    window.draw(dot);
+    // ---------- red dots (4 px radius) at every chain's tip ----------
+    constexpr float       dotRadius = 4.f;
+    constexpr std::size_t dotSteps  = CLOCK_SEGMENTS / 3;
+    m_tipDots.setPrimitiveType(sf::PrimitiveType::Triangles);
+    m_tipDots.resize(numChains * dotSteps * 3);
 
-    // 4) Clockwork ------------------------------------------------------------
-    drawClockwork(window, coeffs, freqs);
+    v = 0;
+    for (std::size_t chain = 0; chain < numChains; ++chain)
+    {
+        const sf::Vector2f tip = m_trail[chain * TRAIL_LENGTH + newest];
+        for (std::size_t s = 0; s < dotSteps; ++s)
+        {
+            m_tipDots[v++] = {tip, sf::Color::Red};
+            m_tipDots[v++] = {tip + m_unitCircle[s * 3] * dotRadius, sf::Color::Red};
+            m_tipDots[v++] = {
+                tip + m_unitCircle[((s + 1) * 3) % CLOCK_SEGMENTS] * dotRadius, sf::Color::Red};
+        }
+    }
+    window.draw(m_tipDots);
 }
 
-void Visualizer::drawClockwork(
-    sf::RenderWindow&                       window,
-    const std::vector<std::complex<float>>& coeffs,
-    const std::vector<int>&                 freqs)
+void Visualizer::rebuildClockworkGeometry(int clockCount)
 {
-    const int          clockCount = m_numComponents;
     const float        ringRadius = 300.f * DRAW_SCALE;
     const sf::Vector2f screenCenter(450.f, 350.f);
 
+    const sf::Color faceColor(157, 124, 79);
+    const sf::Color outlineColor(50, 50, 50);
+    const sf::Color tickColor(80, 80, 80);
+
+    m_clockCenters.resize(clockCount);
+    m_clockRadii.resize(clockCount);
+
+    // faces + outlines + ticks + hands, all as triangles
+    constexpr std::size_t vertsPerFace =
+        CLOCK_SEGMENTS * 3 + CLOCK_SEGMENTS * 6 + CLOCK_TICKS * 6 + 6;
+    m_clockwork.setPrimitiveType(sf::PrimitiveType::Triangles);
+    m_clockwork.resize(vertsPerFace * clockCount);
+
+    std::size_t v = 0;
     for (int i = 0; i < clockCount; ++i)
     {
         // ---- positioning on the ring --------------------------------------
@@ -138,40 +212,103 @@ void Visualizer::drawClockwork(
         const sf::Vector2f center(
             screenCenter.x + std::cos(arrAng) * ringRadius,
             screenCenter.y + std::sin(arrAng) * ringRadius);
+        const float radius = std::hypot(m_termRe[i], m_termIm[i]) * 50.f * DRAW_SCALE;
 
-        // ---- clock face ----------------------------------------------------
-        const float     radius = std::abs(coeffs[i]) * 50.f * DRAW_SCALE;
-        sf::CircleShape face(radius);
-        face.setOrigin(sf::Vector2f(radius, radius));
-        face.setPosition(center);
-        sf::Color color(157, 124, 79);
-        face.setFillColor(color);
-        face.setOutlineColor(sf::Color(50, 50, 50));
-        face.setOutlineThickness(1.5f);
-        window.draw(face);
+        m_clockCenters[i] = center;
+        m_clockRadii[i]   = radius;
+
+        // ---- clock face (triangle fan) + outline (1.5 px ring) --------------
+        for (std::size_t s = 0; s < CLOCK_SEGMENTS; ++s)
+        {
+            const sf::Vector2f& d0 = m_unitCircle[s];
+            const sf::Vector2f& d1 = m_unitCircle[(s + 1) % CLOCK_SEGMENTS];
+
+            m_clockwork[v++] = {center, faceColor};
+            m_clockwork[v++] = {center + d0 * radius, faceColor};
+            m_clockwork[v++] = {center + d1 * radius, faceColor};
+
+            const float outer = radius + 1.5f;
+            writeQuad(
+                m_clockwork,
+                v,
+                center + d0 * radius,
+                center + d1 * radius,
+                center + d1 * outer,
+                center + d0 * outer,
+                outlineColor);
+        }
 
         // ---- tick marks ----------------------------------------------------
-        constexpr int numTicks = 12;
-        for (int t = 0; t < numTicks; ++t)
+        for (std::size_t t = 0; t < CLOCK_TICKS; ++t)
         {
-            const float        tickAng = TWO_PI * t / numTicks;
-            const sf::Vector2f outer(
-                center.x + std::cos(tickAng) * radius, center.y + std::sin(tickAng) * radius);
-            const sf::Vector2f inner(
-                center.x + std::cos(tickAng) * radius * 0.85f,
-                center.y + std::sin(tickAng) * radius * 0.85f);
-            const sf::Vertex tickLine[] = {
-                {outer, sf::Color(80, 80, 80)}, {inner, sf::Color(80, 80, 80)}};
-            window.draw(tickLine, 2, sf::PrimitiveType::Lines);
+            const sf::Vector2f& dir = m_unitCircle[t * CLOCK_SEGMENTS / CLOCK_TICKS];
+            writeLine(
+                m_clockwork,
+                v,
+                center + dir * radius,
+                center + dir * (radius * 0.85f),
+                tickColor);
         }
 
-        // ---- hand ----------------------------------------------------------
-        const float        theta = freqs[i] * m_time;
+        // ---- hand (filled in every frame) ---------------------------------
+        v += 6;
+    }
+}
+
+void Visualizer::drawClockwork(sf::RenderWindow& window)
+{
+    // The clockwork shows the first (largest) chain
+    const int clockCount = std::min(m_numComponents, static_cast<int>(m_chainStart[1]));
+    if (clockCount <= 0)
+        return;
+
+    // Faces, outlines and ticks only depend on the coefficient magnitudes, so they are
+    // rebuilt only when those change. Per frame we just rewrite the hand quads.
+    if (m_clockRadii.size() != static_cast<std::size_t>(clockCount))
+        rebuildClockworkGeometry(clockCount);
+
+    const std::size_t vertsPerFace = m_clockwork.getVertexCount() / clockCount;
+    for (int i = 0; i < clockCount; ++i)
+    {
+        const sf::Vector2f center = m_clockCenters[i];
+        const float        radius = m_clockRadii[i];
+        const float        theta  = m_termFreq[i] * m_time;
         const sf::Vector2f tip(
             center.x + std::cos(theta) * radius, center.y + std::sin(theta) * radius);
-        const sf::Vertex hand[] = {{center, sf::Color::Red}, {tip, sf::Color::Red}};
-        window.draw(hand, 2, sf::PrimitiveType::Lines);
+
+        std::size_t v = (i + 1) * vertsPerFace - 6;
+        writeLine(m_clockwork, v, center, tip, sf::Color::Red);
     }
+
+    window.draw(m_clockwork);
+}
+
+void Visualizer::writeLine(
+    sf::VertexArray& va, std::size_t& v, sf::Vector2f a, sf::Vector2f b, sf::Color color)
+{
+    // 1 px wide quad along a→b
+    const sf::Vector2f d   = b - a;
+    const float        len = std::sqrt(d.x * d.x + d.y * d.y);
+    const sf::Vector2f n =
+        len > 0.f ? sf::Vector2f(-d.y / len * 0.5f, d.x / len * 0.5f) : sf::Vector2f(0.5f, 0.f);
+    writeQuad(va, v, a + n, b + n, b - n, a - n, color);
+}
+
+void Visualizer::writeQuad(
+    sf::VertexArray& va,
+    std::size_t&     v,
+    sf::Vector2f     p0,
+    sf::Vector2f     p1,
+    sf::Vector2f     p2,
+    sf::Vector2f     p3,
+    sf::Color        color)
+{
+    va[v++] = {p0, color};
+    va[v++] = {p1, color};
+    va[v++] = {p2, color};
+    va[v++] = {p0, color};
+    va[v++] = {p2, color};
+    va[v++] = {p3, color};
 }
 
 } // namespace KamonFourier
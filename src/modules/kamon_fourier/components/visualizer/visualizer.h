@@ -1,7 +1,10 @@
 #pragma once
 
+#include "../fourierPipeline/fourierPipeline.h"
+
 #include <SFML/Graphics.hpp>
 #include <complex>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -10,8 +13,10 @@ namespace KamonFourier
 /**
  * @brief A self‑contained helper that draws the epicycle animation (main epicycle + “clockwork”).
  *
- * The class keeps its own animation state (time & traced path) so the caller only has to
- * hand it the current Fourier coefficients + frequencies every frame.
+ * The class keeps its own animation state (time & traced paths). Every contour of the kamon
+ * is one epicycle chain; all chains are evaluated together in one pass over a flat
+ * (structure-of-arrays) term list and drawn in a constant number of draw calls. The
+ * clockwork shows the first (largest) chain.
  */
 class Visualizer
 {
@@ -26,36 +31,78 @@ class Visualizer
     Visualizer(const Visualizer&)            = delete;
     Visualizer& operator=(const Visualizer&) = delete;
 
+    /**
+     * @brief Load the epicycle chains to animate (one per contour) and reset the animation.
+     *
+     * @param chains  Fourier coefficients + frequencies per contour, largest contour first.
+     */
+    void setChains(const std::vector<FourierPipeline::FourierData>& chains);
+
     /**
      * @brief Advance the internal time and render everything onto the window.
      *
      * @param window  Target SFML render window.
-     * @param coeffs  Fourier coefficients (size >= numComponents).
-     * @param freqs   Corresponding frequency indices (size >= numComponents).
      */
-    void updateAndDraw(
-        sf::RenderWindow&                       window,
-        const std::vector<std::complex<float>>& coeffs,
-        const std::vector<int>&                 freqs);
+    void updateAndDraw(sf::RenderWindow& window);
 
-    /** Reset the animation (time = 0, path cleared). */
+    /** Reset the animation (time = 0, paths cleared). */
     void reset();
 
+    /**
+     * @brief Draw `rect` of `texture` (the UI atlas) as the background, scaled to cover the window.
+     *
+     * The texture must outlive the visualizer.
+     */
+    bool setBackground(const sf::Texture& texture, const sf::IntRect& rect);
+
   private:
-    void drawClockwork(
-        sf::RenderWindow&                       window,
-        const std::vector<std::complex<float>>& coeffs,
-        const std::vector<int>&                 freqs);
+    // Evaluate all chains at m_time and append their tips to the trails
+    void evaluateChains();
+    void drawTrails(sf::RenderWindow& window);
+    void drawClockwork(sf::RenderWindow& window);
 
-    bool loadBackground(const std::string& filename);
+    // Rebuild faces, outlines and ticks of all clocks into m_clockwork
+    void rebuildClockworkGeometry(int clockCount);
+    static void writeLine(
+        sf::VertexArray& va, std::size_t& v, sf::Vector2f a, sf::Vector2f b, sf::Color color);
+    static void writeQuad(
+        sf::VertexArray& va,
+        std::size_t&     v,
+        sf::Vector2f     p0,
+        sf::Vector2f     p1,
+        sf::Vector2f     p2,
+        sf::Vector2f     p3,
+        sf::Color        color);
 
-    sf::Texture               m_bgTexture;
     std::optional<sf::Sprite> m_bgSprite;
     bool                      m_bgLoaded{false};
 
-    float                     m_speed{2.f};
-    float                     m_time{0.f};
-    int                       m_numComponents{0};
-    std::vector<sf::Vector2f> m_path; // traced tip path (kept for ~2000 samples)
+    float m_speed{2.f};
+    float m_time{0.f};
+    int   m_numComponents{0};
+
+    // All chains' terms back to back; chain c owns [m_chainStart[c], m_chainStart[c + 1])
+    std::vector<float>         m_termRe;
+    std::vector<float>         m_termIm;
+    std::vector<float>         m_termFreq;
+    std::vector<std::uint32_t> m_chainStart;
+    std::vector<float>         m_rotRe; // per-frame scratch: rotated terms
+    std::vector<float>         m_rotIm;
+
+    // Traced tip paths: one ring buffer of TRAIL_LENGTH samples per chain (all in lockstep)
+    static constexpr std::size_t TRAIL_LENGTH = 400; // > one revolution at speed 1
+    std::vector<sf::Vector2f>    m_trail;
+    std::size_t                  m_trailHead{0};
+    std::size_t                  m_trailSize{0};
+    sf::VertexArray              m_trailLines;
+    sf::VertexArray              m_tipDots;
+
+    // Clockwork: one triangle batch for all faces, outlines, ticks and hands
+    static constexpr std::size_t CLOCK_SEGMENTS = 36; // multiple of CLOCK_TICKS
+    static constexpr std::size_t CLOCK_TICKS    = 12;
+    std::vector<sf::Vector2f>    m_unitCircle;        // CLOCK_SEGMENTS directions
+    std::vector<sf::Vector2f>    m_clockCenters;
+    std::vector<float>           m_clockRadii;
+    sf::VertexArray              m_clockwork;
 };
 } // namespace KamonFourier
@@ -1,10 +1,12 @@
 #include "kamon_fourier.h"
 #include "components/contourExtractor/contourExtractor.h"
+#include "components/fourierCache/fourierCache.h"
+#include "components/fourierPipeline/fourierPipeline.h"
+#include "components/shapeIndex/shapeIndex.h"
 #include "components/visualizer/visualizer.h"
 
 #include <SFML/Graphics.hpp>
 #include <TGUI/TGUI.hpp>
-#include <kissfft/kiss_fft.h>
 #include <opencv2/opencv.hpp>
 
 #include <algorithm>
@@ -23,232 +25,114 @@
 // ──────────────────────────────────────────────────────────────────────────────
 namespace
 {
-using complexf = std::complex<float>;
-
 constexpr float kSpeed         = 1.0f;
 constexpr int   kNumComponents = 48; // bei "24" sieht man gerade noch das kamon
 
-// ──────────────────────────────────────────────────────────────────────────────
-// RAII helper for kiss_fft_cfg
-// ──────────────────────────────────────────────────────────────────────────────
-struct KissFftDeleter
-{
-    void operator()(kiss_fft_state* cfg) const noexcept
-    {
-        std::free(cfg);
-    }
-};
-using KissFftPtr = std::unique_ptr<kiss_fft_state, KissFftDeleter>;
+// Built with `kamon_batch` + `kamon_index build` (same kNumComponents)
+constexpr char kShapeIndexPath[] = "assets/index/kamon.ksi";
+constexpr int  kSimilarTopK      = 5;
+
+// Computed coefficients are cached here, keyed by asset content + pipeline parameters
+constexpr char kCacheDir[] = ".cache/kamon_fourier";
 
 struct FourierState
 {
-    tgui::Panel::Ptr          panel;
-    bool                      initialized = false;
-    std::vector<complexf>     coeffs;
-    std::vector<int>          freqs;
-    std::vector<sf::Vector2f> contourPts;
-    std::vector<sf::Vector2f> path;
-    float                     time = 0.0f;
-    KamonFourier::Visualizer  visualizer{kNumComponents, kSpeed};
+    tgui::Panel::Ptr                                        panel;
+    bool                                                    initialized = false;
+    std::vector<KamonFourier::FourierPipeline::FourierData> chains; // one per contour
+    std::vector<std::vector<sf::Vector2f>>                  contours;
+    KamonFourier::Visualizer                                visualizer{kNumComponents, kSpeed};
+
+    // Similarity search (index loaded on first query)
+    KamonFourier::ShapeIndex shapeIndex;
+    bool                     shapeIndexLoaded = false;
+    tgui::Label::Ptr         similarLabel;
 };
 
 FourierState g_state;
 
 // ──────────────────────────────────────────────────────────────────────────────
-// Normalise input points to a −1..1 range around the origin
+// Load contour and pre-compute Fourier data
 // ──────────────────────────────────────────────────────────────────────────────
-void normalize(std::vector<sf::Vector2f>& pts)
+bool loadOrComputeFourier(const std::string& assetPath, bool isSvg)
 {
-    if (pts.empty())
-        return;
+    using namespace KamonFourier;
 
-    const sf::Vector2f mean = std::accumulate(
-                                  pts.begin(),
-                                  pts.end(),
-                                  sf::Vector2f{},
-                                  [](sf::Vector2f acc, const sf::Vector2f& p)
-                                  {
-                                      acc.x += p.x;
-                                      acc.y += p.y;
-                                      return acc;
-                                  })
-                              / static_cast<float>(pts.size());
-
-    for (auto& p : pts)
-        p -= mean;
-
-    const float maxVal = std::accumulate(
-        pts.begin(),
-        pts.end(),
-        0.0f,
-        [](float m, const sf::Vector2f& p)
-        { return std::max(m, std::max(std::fabs(p.x), std::fabs(p.y))); });
-
-    if (maxVal > 0.0f)
-    {
-        for (auto& p : pts)
-            p /= maxVal;
-    }
-}
-
-// Shift the contour starting point to the opposite side
-void shiftContourToOpposite(std::vector<sf::Vector2f>& pts)
-{
-    if (pts.size() < 2)
-        return;
-
-    const int shift = pts.size() / 2; // halfway around
-    std::rotate(pts.begin(), pts.begin() + shift, pts.end());
-}
-
-void shiftContourToBottomMiddle(std::vector<sf::Vector2f>& pts)
-{
-    if (pts.empty())
-        return;
+    const std::uint64_t key = FourierCache::makeKey(assetPath, kNumComponents);
+    if (key == 0)
+        return false; // asset not readable
 
-    // Step 1: Compute average X
-    float avgX =
-        std::accumulate(
-            pts.begin(), pts.end(), 0.f, [](float sum, const sf::Vector2f& p) { return sum + p.x; })
-        / static_cast<float>(pts.size());
-
-    // Step 2 & 3: Find the point closest to avgX with the lowest Y
-    int   bestIdx  = 0;
-    float bestDist = std::numeric_limits<float>::max();
-
-    for (int i = 0; i < pts.size(); ++i)
-    {
-        float xDist = std::abs(pts[i].x - avgX);
-        float yVal  = pts[i].y;
-
-        float score = xDist + yVal * 0.01f; // prioritize X, break ties with Y
-        if (score < bestDist)
-        {
-            bestDist = score;
-            bestIdx  = i;
-        }
-    }
-
-    // Step 4: Rotate to that index
-    std::rotate(pts.begin(), pts.begin() + bestIdx, pts.end());
-}
-
-// ──────────────────────────────────────────────────────────────────────────────
-// Compute Fourier coefficients using KissFFT
-// ──────────────────────────────────────────────────────────────────────────────
-void computeFourier(const std::vector<sf::Vector2f>& pts)
-{
-    const int N = static_cast<int>(pts.size());
-    if (N < 2)
+    FourierCache::Entry entry;
+    if (!FourierCache::load(kCacheDir, key, entry))
     {
-        std::cerr << "[KamonFourier] Not enough points for FFT.\n";
-        return;
-    }
+        // Every contour / subpath becomes its own epicycle chain (largest first)
+        entry.contours = isSvg ? ContourExtractor::extractAllContoursFromSVG(assetPath)
+                               : ContourExtractor::extractAllContours(assetPath);
+        if (entry.contours.empty())
+            return false;
 
-    std::vector<kiss_fft_cpx> in(N), out(N);
-    for (int i = 0; i < N; ++i)
-    {
-        in[i].r = pts[i].x;
-        in[i].i = pts[i].y;
-    }
+        if (!FourierPipeline::processAll(entry.contours, kNumComponents, entry.chains))
+            return false;
 
-    KissFftPtr cfg{kiss_fft_alloc(N, 0, nullptr, nullptr)};
-    if (!cfg)
-    {
-        std::cerr << "[KamonFourier] KissFFT allocation failed.\n";
-        return;
+        FourierCache::store(kCacheDir, key, entry);
     }
 
-    kiss_fft(cfg.get(), in.data(), out.data());
-
-    const float           invN = 1.0f / static_cast<float>(N);
-    std::vector<complexf> cplx(N);
-    for (int i = 0; i < N; ++i)
-        cplx[i] = {out[i].r * invN, out[i].i * invN};
-
-    // Magnitude-frequency pairs, sorted by magnitude (descending)
-    struct MagIdx
-    {
-        int   freq;
-        float mag;
-    };
-    std::vector<MagIdx> magIndex;
-    magIndex.reserve(N);
-
-    for (int k = 0; k < N; ++k)
-    {
-        const int freq = (k <= N / 2) ? k : k - N;
-        magIndex.push_back({freq, std::abs(cplx[k])});
-    }
-
-    std::partial_sort(
-        magIndex.begin(),
-        magIndex.begin() + std::min(kNumComponents, N),
-        magIndex.end(),
-        [](const MagIdx& a, const MagIdx& b) { return a.mag > b.mag; });
-
-    const int keep = std::min(kNumComponents, N);
-    g_state.coeffs.resize(keep);
-    g_state.freqs.resize(keep);
-
-    for (int i = 0; i < keep; ++i)
-    {
-        const int freq = magIndex[i].freq;
-        const int idx  = (freq >= 0) ? freq : freq + N;
-
-        g_state.coeffs[i] = cplx[idx];
-        g_state.freqs[i]  = freq;
-    }
+    g_state.chains   = std::move(entry.chains);
+    g_state.contours = std::move(entry.contours);
+    return true;
 }
 
-// ──────────────────────────────────────────────────────────────────────────────
-// Load contour and pre-compute Fourier data
-// ──────────────────────────────────────────────────────────────────────────────
 void initFourierData()
 {
     if (g_state.initialized)
         return;
 
-    using namespace KamonFourier::ContourExtractor;
-
     constexpr char kSvgPath[] = "assets/img/kamon.svg";
     constexpr char kPngPath[] = "assets/img/kamon_fourier.png";
 
-    g_state.contourPts = extractContourFromSVG(kSvgPath);
-    if (g_state.contourPts.empty())
+    if (!loadOrComputeFourier(kSvgPath, true))
     {
         std::cerr << "[KamonFourier] Falling back to PNG contour…\n";
-        g_state.contourPts = extractLargestContour(kPngPath);
-    }
-
-    if (g_state.contourPts.empty())
-    {
-        std::cerr << "[KamonFourier] Failed to load contour.\n";
-        return;
+        if (!loadOrComputeFourier(kPngPath, false))
+        {
+            std::cerr << "[KamonFourier] Failed to load contour.\n";
+            return;
+        }
     }
 
-    shiftContourToBottomMiddle(g_state.contourPts);
-    shiftContourToOpposite(g_state.contourPts);
-    normalize(g_state.contourPts);
-    computeFourier(g_state.contourPts);
-
+    g_state.visualizer.setChains(g_state.chains);
     g_state.initialized = true;
-    g_state.path.clear();
-    g_state.time = 0.0f;
 }
 
 // ──────────────────────────────────────────────────────────────────────────────
-// Evaluate truncated Fourier series (epicycles) at angle t
+// Look up the kamon closest to the one currently animated
 // ──────────────────────────────────────────────────────────────────────────────
-[[nodiscard]] complexf evalEpicycles(float t) noexcept
+void showSimilarKamon()
 {
-    complexf sum{};
-    for (std::size_t i = 0; i < g_state.coeffs.size(); ++i)
+    if (!g_state.similarLabel)
+        return;
+
+    initFourierData();
+    if (!g_state.initialized)
+        return;
+
+    if (!g_state.shapeIndexLoaded)
+        g_state.shapeIndexLoaded = g_state.shapeIndex.load(kShapeIndexPath);
+    if (!g_state.shapeIndexLoaded)
     {
-        const float theta = static_cast<float>(g_state.freqs[i]) * t;
-        sum += g_state.coeffs[i] * complexf{std::cos(theta), std::sin(theta)};
+        g_state.similarLabel->setText("No shape index found.");
+        return;
     }
-    return sum;
+
+    // The largest contour (first chain) describes the kamon's outline
+    const auto hits = g_state.shapeIndex.query(
+        KamonFourier::makeDescriptor(g_state.chains.front()),
+        static_cast<std::size_t>(kSimilarTopK));
+
+    std::string text = "Most similar kamon:";
+    for (const auto& hit : hits)
+        text += "\n" + hit.name + "  (" + std::to_string(hit.distance).substr(0, 5) + ")";
+    g_state.similarLabel->setText(text);
 }
 
 } // namespace
@@ -274,6 +158,16 @@ tgui::Panel::Ptr createKamonFourierContainer(const std::function<void()>& onBack
     backBtn->onPress(onBackHome);
     content->add(backBtn);
 
+    auto similarBtn = tgui::Button::create("Find similar");
+    similarBtn->setPosition({0.f, 40.f});
+    similarBtn->onPress(showSimilarKamon);
+    content->add(similarBtn);
+
+    g_state.similarLabel = tgui::Label::create();
+    g_state.similarLabel->setTextSize(14);
+    g_state.similarLabel->setPosition({0.f, 80.f});
+    content->add(g_state.similarLabel);
+
     return g_state.panel;
 }
 
@@ -306,6 +200,17 @@ tgui::Panel::Ptr createFourierTile(const std::function<void()>& openCallback)
     return panel;
 }
 
+bool preloadAssets()
+{
+    initFourierData();
+    return g_state.initialized;
+}
+
+void setBackground(const sf::Texture& atlas, const sf::IntRect& rect)
+{
+    g_state.visualizer.setBackground(atlas, rect);
+}
+
 tgui::Panel::Ptr getFourierPanel()
 {
     return g_state.panel;
@@ -317,7 +222,7 @@ void updateAndDraw(sf::RenderWindow& window)
     if (!g_state.initialized)
         return;
 
-    g_state.visualizer.updateAndDraw(window, g_state.coeffs, g_state.freqs);
+    g_state.visualizer.updateAndDraw(window);
 }
 
 } // namespace KamonFourier
@@ -15,6 +15,13 @@ tgui::Panel::Ptr createFourierTile(const std::function<void()>& openCallback);
 // Return the panel pointer so we can hide/show it.
 tgui::Panel::Ptr getFourierPanel();
 
+// Load the kamon contours and compute (or fetch cached) Fourier coefficients.
+// Touches no GPU or GUI state, so the startup scheduler runs it on a worker thread.
+bool preloadAssets();
+
+// Background of the animation: `rect` of the UI atlas texture
+void setBackground(const sf::Texture& atlas, const sf::IntRect& rect);
+
 // Called every frame while we are on the KamonFourier screen
 // to update the epicycle animation and draw it to the window.
 void updateAndDraw(sf::RenderWindow& window);
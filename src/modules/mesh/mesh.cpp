@@ -133,6 +133,11 @@ tgui::Panel::Ptr Mesh::createMeshContainer(std::function<void()> goBackCallback)
         });
     panel->add(resetBtn);
 
+    return panel;
+}
+
+bool Mesh::loadAssets()
+{
     fs::path base      = fs::path(__FILE__).parent_path().parent_path().parent_path().parent_path();
     fs::path kachel    = base / "meshes" / "kachelmuster.off";
     fs::path ellipsoid = base / "meshes" / "ellipsoid.off";
@@ -191,7 +196,7 @@ tgui::Panel::Ptr Mesh::createMeshContainer(std::function<void()> goBackCallback)
             dataFolder, allColors, currentColors, colorLoaded, currentFrameIdx);
     }
 
-    return panel;
+    return mesh2Loaded || mesh3Loaded || data2Loaded;
 }
 
 tgui::Panel::Ptr Mesh::createMeshTile(
@@ -226,6 +231,11 @@ tgui::Panel::Ptr Mesh::createMeshTile(
 // ────────────────────────────────
 //   ▌  Runtime drawing
 // ────────────────────────────────
+bool Mesh::isAnimating()
+{
+    return playing || dragging;
+}
+
 void Mesh::updateAndDraw(sf::RenderWindow& window)
 {
     // Animate CSV frames if playing
@@ -8,6 +8,11 @@
 namespace Mesh
 {
 tgui::Panel::Ptr createMeshContainer(std::function<void()> goBackCallback);
+// Load the meshes and CSV frames. Touches no GPU or GUI state, so it may run on a worker
+// thread; the screen must not be drawn until it returned. False if nothing could be loaded.
+bool             loadAssets();
 tgui::Panel::Ptr createMeshTile(tgui::Panel::Ptr tile, const std::function<void()>& openCallback);
 void             updateAndDraw(sf::RenderWindow& window);
+// CSV playback is running or the 3-D view is being dragged: the screen changes every frame
+bool             isAnimating();
 } // namespace Mesh
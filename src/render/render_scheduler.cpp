@@ -0,0 +1,35 @@
+#include "render_scheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+
+RenderScheduler::RenderScheduler(Clock::duration idleTimeout) : m_idleTimeout(idleTimeout) {}
+
+void RenderScheduler::wakeAfter(Clock::duration delay)
+{
+    const Clock::time_point at = Clock::now() + delay;
+    if (!m_wakeAt || at < *m_wakeAt)
+        m_wakeAt = at;
+}
+
+sf::Time RenderScheduler::waitTimeout()
+{
+    Clock::duration timeout = m_idleTimeout;
+    if (m_wakeAt)
+    {
+        const Clock::duration remaining = *m_wakeAt - Clock::now();
+        timeout                         = std::min(timeout, remaining);
+        if (remaining <= Clock::duration::zero())
+            m_wakeAt.reset(); // due: this wake-up happens now, timers re-arm if needed
+    }
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+    return sf::microseconds(std::max<std::int64_t>(us.count(), 1000));
+}
+
+void RenderScheduler::beginFrame()
+{
+    m_dirty          = false;
+    m_frameRequested = false;
+    ++m_framesDrawn;
+}
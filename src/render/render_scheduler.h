@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+/**
+ * @brief Decides when the main loop draws a frame and how long it may sleep in between.
+ *
+ * Nothing is redrawn unless something asked for it:
+ *  - `invalidate()` marks the window dirty once (input, new data, a widget that changed);
+ *  - `requestFrame()` asks for the next frame and is repeated every frame by an animation for
+ *    as long as it runs (welcome reveal, Fourier epicycles, mesh playback);
+ *  - `wakeAfter()` makes the loop look again at a deadline without drawing (timers).
+ *
+ * When no frame is due the loop blocks in `sf::Window::waitEvent(waitTimeout())`, so an idle
+ * app wakes only a few times per second to poll its background work.
+ */
+class RenderScheduler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RenderScheduler(Clock::duration idleTimeout = std::chrono::milliseconds(100));
+
+    void invalidate()
+    {
+        m_dirty = true;
+    }
+    void requestFrame()
+    {
+        m_frameRequested = true;
+    }
+    void wakeAfter(Clock::duration delay);
+
+    // A frame has to be drawn in this iteration (never block waiting for events then)
+    [[nodiscard]] bool frameDue() const
+    {
+        return m_dirty || m_frameRequested;
+    }
+
+    // How long the loop may block in waitEvent(): the idle timeout or the time to the next
+    // wake-up, at least 1 ms (a zero timeout would wait forever). Drops a wake-up that is due.
+    [[nodiscard]] sf::Time waitTimeout();
+
+    // Called right before drawing: clears the dirty flag and the frame requests. Requests made
+    // after it (e.g. by an animation while it draws) are for the next frame.
+    void beginFrame();
+
+    // Frames drawn so far, e.g. for an exit report
+    [[nodiscard]] std::size_t framesDrawn() const
+    {
+        return m_framesDrawn;
+    }
+
+  private:
+    Clock::duration                  m_idleTimeout;
+    std::optional<Clock::time_point> m_wakeAt;
+    bool                             m_dirty          = true; // the first frame is always drawn
+    bool                             m_frameRequested = false;
+    std::size_t                      m_framesDrawn    = 0;
+};
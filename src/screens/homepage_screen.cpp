@@ -1,4 +1,5 @@
 #include "homepage_screen.h"
+#include "../atlas/texture_atlas.h"
 #include "../modules/kamon_fourier/kamon_fourier.h"
 #include "../modules/logs_report/logs_report.h"
 #include "../modules/mesh/mesh.h"
@@ -16,6 +17,7 @@ namespace HomepageScreen
 {
 tgui::Panel::Ptr createHomepagePanel(
     const sf::Vector2u&   windowSize,
+    const TextureAtlas&   atlas,
     std::function<void()> onLogsClick,
     std::function<void()> onMeshClick,
     std::function<void()> onFourierClick,
@@ -53,7 +55,7 @@ tgui::Panel::Ptr createHomepagePanel(
     homeContent->setPosition(0, 50);
     panel->add(homeContent);
 
-    auto logo = tgui::Picture::create("assets/img/kamon_pixelated.png");
+    auto logo = tgui::Picture::create(atlas.tguiTexture("kamon_pixelated"));
     logo->setSize(180, 180);
     logo->setPosition({"(&.width - width)/2", 50});
     homeContent->add(logo);
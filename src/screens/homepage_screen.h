@@ -5,14 +5,17 @@
 #include <TGUI/Backend/SFML-Graphics.hpp>
 #include <functional>
 
+class TextureAtlas;
+
 namespace HomepageScreen
 {
 tgui::Panel::Ptr createHomepagePanel(
     const sf::Vector2u&   windowSize,
+    const TextureAtlas&   atlas,
     std::function<void()> onLogsClick,
     std::function<void()> onMeshClick,
     std::function<void()> onFourierClick,
     bool&                 modeOnlineRef,
     std::function<void()> onMenuClick,
     std::function<void()> onShutdownClick);
-}
+} // namespace HomepageScreen
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Sparkles orbiting a centre point, drawn as one textured triangle batch.
+ *
+ * Particle state is kept as structure-of-arrays (phase, radius, scale, age, lifetime). One loop
+ * per frame advances every particle, drops expired ones and writes its quad into a single
+ * vertex array, so the cost is one draw call regardless of the particle count.
+ */
+class SparkleSystem
+{
+  public:
+    // Sprite to draw (usually a rect of the UI atlas); the texture must outlive the system
+    void setTexture(const sf::Texture& texture, const sf::IntRect& rect)
+    {
+        m_texture = &texture;
+        m_rect    = rect;
+    }
+
+    // Orbit speed of all particles, radians per second
+    void setAngularSpeed(float radiansPerSecond)
+    {
+        m_angularSpeed = radiansPerSecond;
+    }
+
+    // `count` particles spread evenly over `arc` radians, starting at `startPhase`.
+    // They fade out over the last `fadeOut` seconds of their `lifetime`.
+    void emitRing(
+        std::size_t count,
+        float       radius,
+        float       arc,
+        float       scale,
+        float       lifetime,
+        float       fadeOut    = 0.f,
+        float       startPhase = 0.f)
+    {
+        const std::size_t size = m_phase.size() + count;
+        m_phase.reserve(size);
+        m_radius.reserve(size);
+        m_scale.reserve(size);
+        m_age.reserve(size);
+        m_lifetime.reserve(size);
+        m_fadeOut.reserve(size);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_phase.push_back(startPhase + static_cast<float>(i) / count * arc);
+            m_radius.push_back(radius);
+            m_scale.push_back(scale);
+            m_age.push_back(0.f);
+            m_lifetime.push_back(lifetime);
+            m_fadeOut.push_back(fadeOut);
+        }
+    }
+
+    void clear()
+    {
+        m_phase.clear();
+        m_radius.clear();
+        m_scale.clear();
+        m_age.clear();
+        m_lifetime.clear();
+        m_fadeOut.clear();
+        m_vertices.clear();
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_phase.size();
+    }
+
+    // Advance by `dt` seconds, drop expired particles and rebuild the vertex batch
+    void update(float dt, sf::Vector2f center)
+    {
+        const sf::Vector2f half(m_rect.size.x * 0.5f, m_rect.size.y * 0.5f);
+        const sf::Vector2f uv0(m_rect.position);
+        const sf::Vector2f uv1 = uv0 + sf::Vector2f(m_rect.size);
+
+        m_vertices.resize(m_phase.size() * 6);
+        std::size_t alive = 0;
+        for (std::size_t i = 0; i < m_phase.size(); ++i)
+        {
+            const float age = m_age[i] + dt;
+            if (age >= m_lifetime[i])
+                continue;
+
+            // Compact in place: survivor i moves to slot `alive`
+            const float phase = m_phase[i] + m_angularSpeed * dt;
+            m_phase[alive]    = phase;
+            m_radius[alive]   = m_radius[i];
+            m_scale[alive]    = m_scale[i];
+            m_age[alive]      = age;
+            m_lifetime[alive] = m_lifetime[i];
+            m_fadeOut[alive]  = m_fadeOut[i];
+
+            const float remaining = m_lifetime[i] - age;
+            const float fade =
+                m_fadeOut[i] > 0.f ? std::min(1.f, remaining / m_fadeOut[i]) : 1.f;
+            const sf::Color    color(255, 255, 255, static_cast<std::uint8_t>(255.f * fade));
+            const sf::Vector2f pos =
+                center + m_radius[i] * sf::Vector2f(std::cos(phase), std::sin(phase));
+            const sf::Vector2f h = half * m_scale[i];
+
+            sf::Vertex* v = &m_vertices[alive * 6];
+            v[0]          = {pos + sf::Vector2f(-h.x, -h.y), color, {uv0.x, uv0.y}};
+            v[1]          = {pos + sf::Vector2f(h.x, -h.y), color, {uv1.x, uv0.y}};
+            v[2]          = {pos + sf::Vector2f(h.x, h.y), color, {uv1.x, uv1.y}};
+            v[3]          = v[0];
+            v[4]          = v[2];
+            v[5]          = {pos + sf::Vector2f(-h.x, h.y), color, {uv0.x, uv1.y}};
+            ++alive;
+        }
+
+        m_phase.resize(alive);
+        m_radius.resize(alive);
+        m_scale.resize(alive);
+        m_age.resize(alive);
+        m_lifetime.resize(alive);
+        m_fadeOut.resize(alive);
+        m_vertices.resize(alive * 6);
+    }
+
+    void draw(sf::RenderTarget& target) const
+    {
+        if (!m_texture || m_vertices.getVertexCount() == 0)
+            return;
+
+        sf::RenderStates states;
+        states.texture = m_texture;
+        target.draw(m_vertices, states);
+    }
+
+  private:
+    const sf::Texture* m_texture = nullptr;
+    sf::IntRect        m_rect;
+    float              m_angularSpeed = 3.f;
+
+    std::vector<float> m_phase;    // angle on the orbit, radians
+    std::vector<float> m_radius;   // orbit radius, pixels
+    std::vector<float> m_scale;    // sprite scale
+    std::vector<float> m_age;      // seconds since emission
+    std::vector<float> m_lifetime; // seconds until removal
+    std::vector<float> m_fadeOut;  // seconds of alpha fade before removal
+
+    sf::VertexArray m_vertices{sf::PrimitiveType::Triangles};
+};
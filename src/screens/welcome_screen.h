@@ -1,12 +1,18 @@
 #pragma once
 
+#include "../atlas/texture_atlas.h"
+#include "sparkle_system.h"
+
 #include <SFML/Graphics.hpp>
 #include <TGUI/AllWidgets.hpp>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 class WelcomeScreen
@@ -14,6 +20,7 @@ class WelcomeScreen
   public:
     WelcomeScreen(
         tgui::Gui&          gui,
+        TextureAtlas&       atlas,
         const sf::Vector2u& windowSize,
         const std::string&  message   = "Welcome to Lucy!",
         sf::Color           bgColor   = sf::Color(255, 255, 255),
@@ -51,9 +58,9 @@ class WelcomeScreen
         m_currentMask  = cv::Mat::zeros(m_blackMask.size(), CV_8U);
         int revealRows = static_cast<int>(0.6 * m_blackMask.rows);
         m_blackMask.rowRange(0, revealRows).copyTo(m_currentMask.rowRange(0, revealRows));
+        computeRevealSchedule();
 
-        m_cvFrameRGBA.create(160, 160, CV_8UC4);
-        updateMaskTexture();
+        createMaskTexture(atlas);
         m_videoDisplay->setSize({240, 240});
 
         // Label
@@ -63,28 +70,19 @@ class WelcomeScreen
         m_label->setPosition({"(&.width - width)/2", "60%"});
         m_panel->add(m_label);
 
-        // Load sparkle texture
-        if (!m_sparkleTexture.loadFromFile("assets/img/sparkle.png"))
-        {
+        // Startup progress (see setStatus)
+        m_statusLabel = tgui::Label::create();
+        m_statusLabel->setTextSize(16);
+        m_statusLabel->getRenderer()->setTextColor(textColor);
+        m_statusLabel->setPosition({"(&.width - width)/2", "68%"});
+        m_panel->add(m_statusLabel);
+
+        // Sparkle sprite from the UI atlas (particles are emitted when the reveal finishes)
+        const sf::IntRect sparkleRect = atlas.rect("sparkle");
+        if (!atlas.isLoaded() || sparkleRect.size.x <= 0)
             std::cerr << "Failed to load sparkle image!\n";
-        }
         else
-        {
-            const size_t sparkleCount = 6;           // Quarter-circle sparkles
-            const float  quarterArc   = M_PI / 2.0f; // 90 degrees
-
-            for (size_t i = 0; i < sparkleCount; ++i)
-            {
-                sf::Sprite sprite(m_sparkleTexture);
-                sprite.setOrigin(sf::Vector2f(m_sparkleTexture.getSize()) / 2.f);
-
-                // Store angle offset in sprite rotation (reused)
-                float angleOffset = static_cast<float>(i) / sparkleCount * quarterArc;
-                sprite.setRotation(sf::radians(angleOffset));
-
-                m_sparkles.emplace_back(sprite);
-            }
-        }
+            m_sparkles.setTexture(atlas.texture(), sparkleRect);
 
         m_panel->setVisible(true);
         m_clock.restart();
@@ -119,19 +117,15 @@ class WelcomeScreen
             {
                 m_lastFrameTime = t;
 
-                cv::Mat candidates, neighbours, revealNow;
-                cv::bitwise_and(m_blackMask, ~m_currentMask, candidates);
-                neighbours = getNeighbourVisiblePixels(m_currentMask);
-                cv::bitwise_and(candidates, neighbours, revealNow);
-
-                if (cv::countNonZero(revealNow) == 0)
+                // Reveal one more BFS ring: everything at most `m_revealStep` away
+                if (++m_revealStep > m_maxRevealDistance)
                 {
                     m_animationDone = true;
                     m_sparkleClock.restart();
+                    reportTextureUploads();
                 }
                 else
                 {
-                    m_currentMask.setTo(255, revealNow);
                     updateMaskTexture();
                 }
             }
@@ -141,11 +135,11 @@ class WelcomeScreen
         {
             m_sparkleStarted = true;
             m_sparkleClock.restart();
-        }
+            m_lastSparkleTime = 0.f;
 
-        if (m_sparkleStarted && t >= m_duration && t < m_duration + m_sparkleDuration)
-        {
-            renderSparkles();
+            // Quarter-circle ring, alive until the panel has faded out
+            const float lifetime = m_duration + m_sparkleDuration - t;
+            m_sparkles.emitRing(kSparkleCount, 140.f, M_PI / 2.0f, 0.8f, lifetime, m_fadeDuration);
         }
 
         if (t >= m_duration + m_sparkleDuration)
@@ -161,10 +155,19 @@ class WelcomeScreen
         return m_panel && m_panel->isVisible();
     }
 
+    // One line of startup progress under the welcome message
+    void setStatus(const std::string& text)
+    {
+        if (m_statusLabel && m_statusLabel->getText() != text)
+            m_statusLabel->setText(text);
+    }
+
+    // Advance and draw all sparkles (one draw call); called after the GUI was drawn
     void renderSparkles()
     {
-        float time   = m_sparkleClock.getElapsedTime().asSeconds();
-        float radius = 140.0f;
+        const float time  = m_sparkleClock.getElapsedTime().asSeconds();
+        const float dt    = time - m_lastSparkleTime;
+        m_lastSparkleTime = time;
 
         sf::Vector2f videoPos  = m_videoDisplay->getAbsolutePosition();
         sf::Vector2f videoSize = m_videoDisplay->getSize();
@@ -174,57 +177,140 @@ class WelcomeScreen
         if (!renderWindow)
             return;
 
-        for (auto& sparkle : m_sparkles)
+        m_sparkles.update(dt, center);
+        m_sparkles.draw(*renderWindow);
+    }
+
+  private:
+    // Full frame from the initial mask into the atlas' reserved "welcome_mask" slot, which is
+    // then updated in place
+    void createMaskTexture(TextureAtlas& atlas)
+    {
+        m_cvFrameRGBA.create(m_blackMask.size(), CV_8UC4);
+        m_cvFrameRGBA.setTo(cv::Scalar(255, 255, 255, 255));
+        m_cvFrameRGBA.setTo(cv::Scalar(0, 0, 0, 255), m_currentMask);
+
+        const sf::IntRect slot = atlas.rect("welcome_mask");
+        if (!atlas.isLoaded() || slot.size != sf::Vector2i(m_cvFrameRGBA.cols, m_cvFrameRGBA.rows))
         {
-            float angleOffset = sparkle.getRotation().asRadians();
-            float angle       = angleOffset + time * 3.0f;
-            float x           = center.x + radius * std::cos(angle);
-            float y           = center.y + radius * std::sin(angle);
-            sparkle.setPosition({x, y});
-            sparkle.setScale({0.8f, 0.8f});
-            renderWindow->draw(sparkle);
+            std::cerr << "Error: UI atlas has no " << m_cvFrameRGBA.cols << "x"
+                      << m_cvFrameRGBA.rows << " welcome_mask slot.\n";
+            return;
         }
+
+        m_maskTexture = &atlas.texture();
+        m_maskOrigin  = sf::Vector2u(slot.position);
+        m_maskTexture->update(
+            m_cvFrameRGBA.data,
+            {static_cast<unsigned>(m_cvFrameRGBA.cols), static_cast<unsigned>(m_cvFrameRGBA.rows)},
+            m_maskOrigin);
+        m_videoDisplay->getRenderer()->setTexture(atlas.tguiTexture("welcome_mask"));
+
+        m_uploadBytes = m_cvFrameRGBA.total() * m_cvFrameRGBA.elemSize();
+        m_uploadCount = 1;
     }
 
-  private:
+    // Paint the pixels revealed at `m_revealStep` into the RGBA frame and upload only the band
+    // of rows they span. No allocation happens here.
     void updateMaskTexture()
     {
-        cv::Mat frameGray(160, 160, CV_8U, cv::Scalar(255));
-        frameGray.setTo(0, m_currentMask);
-
-        cv::Mat rgba;
-        cv::cvtColor(frameGray, rgba, cv::COLOR_GRAY2RGBA);
-        m_sfmlVideoTexture.update(rgba.data);
-        m_tguiVideoTexture.loadFromPixelData({160, 160}, rgba.data);
-        m_videoDisplay->getRenderer()->setTexture(m_tguiVideoTexture);
+        if (!m_maskTexture)
+            return;
+
+        const auto [firstRow, lastRow] = m_stepRows[m_revealStep];
+        for (int y = firstRow; y <= lastRow; ++y)
+        {
+            const auto* distance = m_revealDistance.ptr<std::uint16_t>(y);
+            auto*       pixel    = m_cvFrameRGBA.ptr<cv::Vec4b>(y);
+            for (int x = 0; x < m_cvFrameRGBA.cols; ++x)
+            {
+                if (distance[x] == m_revealStep)
+                    pixel[x] = cv::Vec4b(0, 0, 0, 255);
+            }
+        }
+
+        const auto width    = static_cast<unsigned>(m_cvFrameRGBA.cols);
+        const auto rowCount = static_cast<unsigned>(lastRow - firstRow + 1);
+        m_maskTexture->update(
+            m_cvFrameRGBA.ptr(firstRow),
+            {width, rowCount},
+            m_maskOrigin + sf::Vector2u(0, static_cast<unsigned>(firstRow)));
+        m_uploadBytes += rowCount * m_cvFrameRGBA.step[0];
+        ++m_uploadCount;
     }
 
-    cv::Mat getNeighbourVisiblePixels(const cv::Mat& mask)
+    void reportTextureUploads() const
     {
-        cv::Mat up, down, left, right;
-        cv::Mat result = cv::Mat::zeros(mask.size(), CV_8U);
-
-        cv::copyMakeBorder(mask, up, 1, 0, 0, 0, cv::BORDER_CONSTANT, 0);
-        up = up.rowRange(0, mask.rows);
-        cv::copyMakeBorder(mask, down, 0, 1, 0, 0, cv::BORDER_CONSTANT, 0);
-        down = down.rowRange(1, mask.rows + 1);
-        cv::copyMakeBorder(mask, left, 0, 0, 1, 0, cv::BORDER_CONSTANT, 0);
-        left = left.colRange(0, mask.cols);
-        cv::copyMakeBorder(mask, right, 0, 0, 0, 1, cv::BORDER_CONSTANT, 0);
-        right = right.colRange(1, mask.cols + 1);
-
-        result |= up;
-        result |= down;
-        result |= left;
-        result |= right;
-
-        return result;
+        if (m_uploadCount == 0)
+            return; // no atlas slot: nothing was uploaded
+
+        const std::size_t frameBytes = m_cvFrameRGBA.total() * m_cvFrameRGBA.elemSize();
+        std::cout << "[WelcomeScreen] Reveal: " << m_uploadCount << " texture uploads, "
+                  << m_uploadBytes / 1024.0 << " KiB total (" << m_uploadBytes / m_uploadCount
+                  << " B/upload vs " << frameBytes << " B full frame), 0 per-frame allocations\n";
+    }
+
+    // 4-connected BFS over the black pixels, seeded with the initially revealed ones.
+    // Pixel distance = the reveal step at which it appears; unreachable pixels never do.
+    // Also records, per step, the band of rows that step touches (for texture updates).
+    void computeRevealSchedule()
+    {
+        constexpr std::uint16_t unreachable = std::numeric_limits<std::uint16_t>::max();
+
+        const int rows = m_blackMask.rows;
+        const int cols = m_blackMask.cols;
+        m_revealDistance.create(rows, cols, CV_16U);
+        m_revealDistance.setTo(unreachable);
+
+        std::vector<int> queue;
+        queue.reserve(static_cast<std::size_t>(rows) * cols);
+        for (int y = 0; y < rows; ++y)
+        {
+            for (int x = 0; x < cols; ++x)
+            {
+                if (m_currentMask.at<uchar>(y, x))
+                {
+                    m_revealDistance.at<std::uint16_t>(y, x) = 0;
+                    queue.push_back(y * cols + x);
+                }
+            }
+        }
+
+        m_maxRevealDistance = 0;
+        m_stepRows.assign(1, {0, rows - 1});
+        for (std::size_t head = 0; head < queue.size(); ++head)
+        {
+            const int           y    = queue[head] / cols;
+            const int           x    = queue[head] % cols;
+            const std::uint16_t next = m_revealDistance.at<std::uint16_t>(y, x) + 1;
+
+            const int neighbours[4][2] = {{y - 1, x}, {y + 1, x}, {y, x - 1}, {y, x + 1}};
+            for (const auto& [ny, nx] : neighbours)
+            {
+                if (ny < 0 || ny >= rows || nx < 0 || nx >= cols)
+                    continue;
+                if (!m_blackMask.at<uchar>(ny, nx)
+                    || m_revealDistance.at<std::uint16_t>(ny, nx) != unreachable)
+                    continue;
+
+                // FIFO order: distances never decrease, so the last one is the maximum
+                m_revealDistance.at<std::uint16_t>(ny, nx) = next;
+                m_maxRevealDistance                        = next;
+                if (m_stepRows.size() <= next)
+                    m_stepRows.emplace_back(ny, ny);
+                m_stepRows[next].first  = std::min(m_stepRows[next].first, ny);
+                m_stepRows[next].second = std::max(m_stepRows[next].second, ny);
+                queue.push_back(ny * cols + nx);
+            }
+        }
+        m_revealStep = 0;
     }
 
   private:
     tgui::Gui&         m_gui;
     tgui::Panel::Ptr   m_panel;
     tgui::Label::Ptr   m_label;
+    tgui::Label::Ptr   m_statusLabel;
     tgui::Picture::Ptr m_videoDisplay;
 
     sf::Clock   m_clock;
@@ -235,16 +321,25 @@ class WelcomeScreen
     bool        m_animationDone;
 
     // Sparkle animation
-    sf::Texture             m_sparkleTexture;
-    std::vector<sf::Sprite> m_sparkles;
-    bool                    m_sparkleStarted;
-    float                   m_sparkleDuration;
-    sf::Clock               m_sparkleClock;
+    static constexpr std::size_t kSparkleCount = 6;
+    SparkleSystem                m_sparkles;
+    bool                         m_sparkleStarted;
+    float                        m_sparkleDuration;
+    sf::Clock                    m_sparkleClock;
+    float                        m_lastSparkleTime = 0.f;
 
     // OpenCV
-    cv::Mat       m_blackMask;
-    cv::Mat       m_currentMask;
-    cv::Mat       m_cvFrameRGBA;
-    sf::Texture   m_sfmlVideoTexture;
-    tgui::Texture m_tguiVideoTexture;
+    cv::Mat                          m_blackMask;
+    cv::Mat                          m_currentMask;    // initially revealed pixels
+    cv::Mat                          m_revealDistance; // CV_16U reveal step per pixel
+    std::vector<std::pair<int, int>> m_stepRows;       // first / last row touched per step
+    int                              m_revealStep        = 0;
+    int                              m_maxRevealDistance = 0;
+
+    // Persistent RGBA frame and the atlas slot it is uploaded into
+    cv::Mat      m_cvFrameRGBA;
+    sf::Texture* m_maskTexture = nullptr; // the UI atlas texture
+    sf::Vector2u m_maskOrigin;            // top-left of the welcome_mask slot
+    std::size_t  m_uploadBytes = 0;
+    std::size_t  m_uploadCount = 0;
 };
@@ -0,0 +1,201 @@
+#include "startup_scheduler.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+StartupScheduler::~StartupScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true; // running tasks finish, nothing new starts
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+StartupScheduler::TaskId StartupScheduler::add(
+    std::string           name,
+    std::function<bool()> work,
+    std::vector<TaskId>   dependencies,
+    std::function<void()> onReady,
+    std::function<void()> onFailed)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Task task;
+    task.name         = std::move(name);
+    task.work         = std::move(work);
+    task.dependencies = std::move(dependencies);
+    task.onReady      = std::move(onReady);
+    task.onFailed     = std::move(onFailed);
+    m_tasks.push_back(std::move(task));
+    return m_tasks.size() - 1;
+}
+
+void StartupScheduler::start(unsigned workerCount)
+{
+    if (workerCount == 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::min<unsigned>(workerCount, static_cast<unsigned>(m_tasks.size()));
+
+    for (unsigned i = 0; i < workerCount; ++i)
+        m_workers.emplace_back(&StartupScheduler::workerLoop, this);
+}
+
+bool StartupScheduler::takeRunnable(TaskId& id)
+{
+    // Dependencies always have lower ids (add() only accepts existing ones), so a single pass
+    // in id order also propagates skips down a dependency chain.
+    for (TaskId i = 0; i < m_tasks.size(); ++i)
+    {
+        Task& task = m_tasks[i];
+        if (task.state != State::Pending)
+            continue;
+
+        bool ready  = true;
+        bool broken = false;
+        for (const TaskId dep : task.dependencies)
+        {
+            const State depState = m_tasks[dep].state;
+            broken |= depState == State::Failed || depState == State::Skipped;
+            ready &= depState == State::Succeeded;
+        }
+
+        if (broken)
+        {
+            task.state = State::Skipped;
+            ++m_finishedCount;
+            m_completed.push_back(i);
+        }
+        else if (ready)
+        {
+            task.state   = State::Running;
+            task.started = std::chrono::steady_clock::now();
+            id           = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void StartupScheduler::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        TaskId id    = 0;
+        bool   taken = false;
+        m_cv.wait(
+            lock,
+            [&]
+            {
+                return m_stopping || (taken = takeRunnable(id))
+                       || m_finishedCount == m_tasks.size();
+            });
+        if (!taken)
+        {
+            m_cv.notify_all(); // skips may have finished the schedule for everyone
+            return;
+        }
+
+        Task& task = m_tasks[id];
+        lock.unlock();
+
+        bool ok = false;
+        try
+        {
+            ok = task.work();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[Startup] " << task.name << " threw: " << e.what() << '\n';
+        }
+
+        lock.lock();
+        task.ms = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - task.started)
+                      .count();
+        task.state = ok ? State::Succeeded : State::Failed;
+        ++m_finishedCount;
+        m_completed.push_back(id);
+        m_cv.notify_all();
+    }
+}
+
+void StartupScheduler::poll()
+{
+    std::vector<TaskId> done;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        done.swap(m_completed);
+    }
+
+    for (const TaskId id : done)
+    {
+        const Task& task = m_tasks[id];
+        ++m_deliveredCount;
+        const auto count = " (" + std::to_string(m_deliveredCount) + "/"
+                           + std::to_string(m_tasks.size()) + ")\n";
+
+        switch (task.state)
+        {
+        case State::Succeeded:
+            std::cout << "[Startup] " << task.name << " ready in " << task.ms << " ms" << count;
+            if (task.onReady)
+                task.onReady();
+            break;
+        case State::Failed:
+            std::cerr << "[Startup] " << task.name << " failed after " << task.ms << " ms"
+                      << count;
+            if (task.onFailed)
+                task.onFailed();
+            break;
+        default:
+            std::cerr << "[Startup] " << task.name << " skipped (dependency failed)" << count;
+            if (task.onFailed)
+                task.onFailed();
+            break;
+        }
+    }
+}
+
+float StartupScheduler::progress() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tasks.empty() ? 1.f
+                           : static_cast<float>(m_finishedCount)
+                                 / static_cast<float>(m_tasks.size());
+}
+
+std::string StartupScheduler::status() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finishedCount == m_tasks.size())
+    {
+        std::string failed;
+        for (const auto& task : m_tasks)
+        {
+            if (task.state == State::Failed || task.state == State::Skipped)
+                failed += (failed.empty() ? "" : ", ") + task.name;
+        }
+        return failed.empty() ? "Ready" : "Ready, failed: " + failed;
+    }
+
+    std::string running;
+    for (const auto& task : m_tasks)
+    {
+        if (task.state == State::Running)
+            running += (running.empty() ? "" : ", ") + task.name;
+    }
+    return "Loading " + (running.empty() ? std::string("…") : running) + " ("
+           + std::to_string(m_finishedCount) + "/" + std::to_string(m_tasks.size()) + ")";
+}
+
+bool StartupScheduler::finished() const
+{
+    return m_deliveredCount == m_tasks.size();
+}
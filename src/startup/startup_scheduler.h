@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs the app's startup work (font, mesh and kamon assets) on worker threads.
+ *
+ * Tasks are registered up front with their dependencies and run concurrently once every
+ * dependency has succeeded; a task whose dependency failed is skipped. Each task may carry an
+ * `onReady` and an `onFailed` callback that are executed on the main thread from `poll()`, which
+ * is where widgets and textures are touched. Progress is reported through `progress()` /
+ * `status()` and logged.
+ */
+class StartupScheduler
+{
+  public:
+    using TaskId = std::size_t;
+
+    StartupScheduler() = default;
+    ~StartupScheduler();
+
+    StartupScheduler(const StartupScheduler&)            = delete;
+    StartupScheduler& operator=(const StartupScheduler&) = delete;
+
+    /**
+     * @param name          Shown in logs and in the status line.
+     * @param work          Runs on a worker thread; returns false on failure.
+     * @param dependencies  Tasks that must have succeeded before `work` starts.
+     * @param onReady       Runs on the main thread (from poll()) after `work` succeeded.
+     * @param onFailed      Runs on the main thread (from poll()) if `work` failed or threw, or
+     *                      was skipped because a dependency failed.
+     */
+    TaskId add(
+        std::string           name,
+        std::function<bool()> work,
+        std::vector<TaskId>   dependencies = {},
+        std::function<void()> onReady      = {},
+        std::function<void()> onFailed     = {});
+
+    // Spawn the workers (0 = one per hardware thread, capped by the number of tasks).
+    // No tasks may be added afterwards.
+    void start(unsigned workerCount = 0);
+
+    // Main thread, once per frame: run the onReady callbacks of tasks finished since last call
+    void poll();
+
+    [[nodiscard]] float       progress() const; // finished tasks / all tasks, 0..1
+    [[nodiscard]] std::string status() const;   // e.g. "Loading model… (2/5)", "Ready"
+    [[nodiscard]] bool        finished() const; // every task done and delivered by poll()
+
+  private:
+    enum class State
+    {
+        Pending,
+        Running,
+        Succeeded,
+        Failed,
+        Skipped
+    };
+
+    struct Task
+    {
+        std::string                           name;
+        std::function<bool()>                 work;
+        std::vector<TaskId>                   dependencies;
+        std::function<void()>                 onReady;
+        std::function<void()>                 onFailed;
+        State                                 state = State::Pending;
+        std::chrono::steady_clock::time_point started;
+        double                                ms = 0.0;
+    };
+
+    void workerLoop();
+
+    // Next runnable task (marks skipped ones on the way); requires m_mutex
+    bool takeRunnable(TaskId& id);
+
+    mutable std::mutex       m_mutex;
+    std::condition_variable  m_cv;
+    std::vector<Task>        m_tasks;
+    std::vector<TaskId>      m_completed; // finished, waiting for poll()
+    std::vector<std::thread> m_workers;
+    std::size_t              m_finishedCount  = 0;
+    std::size_t              m_deliveredCount = 0;
+    bool                     m_stopping       = false;
+};
@@ -0,0 +1,187 @@
+// Build-time packer for the UI texture atlas.
+//
+//   atlas_packer <out-prefix> <image>... [--reserve NAME WxH]... [--padding N]
+//
+// Packs every image (and every reserved, initially transparent slot for textures drawn at
+// runtime) into <out-prefix>.png and writes the sprite rectangles to <out-prefix>.atlas:
+//
+//   image <file name of the png> <width> <height>
+//   sprite <name> <x> <y> <w> <h>
+//
+// Sprite names are the image file names without extension. CMake runs this for the `ui_atlas`
+// target; the runtime side is TextureAtlas (src/atlas).
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+struct Item
+{
+    std::string name;
+    cv::Mat     pixels; // BGRA; empty for reserved slots
+    int         width  = 0;
+    int         height = 0;
+    int         x      = 0;
+    int         y      = 0;
+};
+
+bool loadItem(const fs::path& path, Item& item)
+{
+    cv::Mat img = cv::imread(path.string(), cv::IMREAD_UNCHANGED);
+    if (img.empty())
+    {
+        std::cerr << "atlas_packer: cannot read " << path << '\n';
+        return false;
+    }
+
+    switch (img.channels())
+    {
+    case 1:
+        cv::cvtColor(img, img, cv::COLOR_GRAY2BGRA);
+        break;
+    case 3:
+        cv::cvtColor(img, img, cv::COLOR_BGR2BGRA);
+        break;
+    default:
+        break;
+    }
+    if (img.depth() != CV_8U)
+        img.convertTo(img, CV_8U, 1.0 / 257.0); // 16-bit PNGs
+
+    item.name   = path.stem().string();
+    item.pixels = img;
+    item.width  = img.cols;
+    item.height = img.rows;
+    return true;
+}
+
+// Shelf packing, tallest first, into a fixed width; returns the used height
+int pack(std::vector<Item>& items, int width, int padding)
+{
+    int x = padding, y = padding, shelfHeight = 0;
+    for (auto& item : items)
+    {
+        if (x + item.width + padding > width)
+        {
+            x = padding;
+            y += shelfHeight + padding;
+            shelfHeight = 0;
+        }
+        item.x = x;
+        item.y = y;
+        x += item.width + padding;
+        shelfHeight = std::max(shelfHeight, item.height);
+    }
+    return y + shelfHeight + padding;
+}
+
+int nextPowerOfTwo(int v)
+{
+    int p = 1;
+    while (p < v)
+        p <<= 1;
+    return p;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: atlas_packer <out-prefix> <image>... [--reserve NAME WxH]... "
+                     "[--padding N]\n";
+        return 1;
+    }
+
+    const fs::path    prefix  = argv[1];
+    int               padding = 2;
+    std::vector<Item> items;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--padding" && i + 1 < argc)
+            padding = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--reserve" && i + 2 < argc)
+        {
+            Item slot;
+            slot.name              = argv[++i];
+            const std::string size = argv[++i];
+            const auto        xPos = size.find('x');
+            if (xPos == std::string::npos)
+            {
+                std::cerr << "atlas_packer: bad slot size " << size << " (expected WxH)\n";
+                return 1;
+            }
+            slot.width  = std::stoi(size.substr(0, xPos));
+            slot.height = std::stoi(size.substr(xPos + 1));
+            items.push_back(std::move(slot));
+        }
+        else
+        {
+            Item item;
+            if (!loadItem(arg, item))
+                return 1;
+            items.push_back(std::move(item));
+        }
+    }
+
+    std::stable_sort(
+        items.begin(),
+        items.end(),
+        [](const Item& a, const Item& b) { return a.height > b.height; });
+
+    // Power-of-two width no smaller than the widest item or the side of a square of equal area
+    long long area   = 0;
+    int       widest = 0;
+    for (const auto& item : items)
+    {
+        area += static_cast<long long>(item.width + padding) * (item.height + padding);
+        widest = std::max(widest, item.width + 2 * padding);
+    }
+    const int width = nextPowerOfTwo(
+        std::max(widest, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area))))));
+    const int height = pack(items, width, padding);
+
+    cv::Mat atlas(height, width, CV_8UC4, cv::Scalar(0, 0, 0, 0));
+    for (const auto& item : items)
+    {
+        if (!item.pixels.empty())
+            item.pixels.copyTo(atlas(cv::Rect(item.x, item.y, item.width, item.height)));
+    }
+
+    fs::create_directories(prefix.parent_path().empty() ? "." : prefix.parent_path());
+    const fs::path imagePath    = fs::path(prefix).concat(".png");
+    const fs::path manifestPath = fs::path(prefix).concat(".atlas");
+    if (!cv::imwrite(imagePath.string(), atlas))
+    {
+        std::cerr << "atlas_packer: cannot write " << imagePath << '\n';
+        return 1;
+    }
+
+    std::ofstream manifest(manifestPath);
+    if (!manifest.is_open())
+    {
+        std::cerr << "atlas_packer: cannot write " << manifestPath << '\n';
+        return 1;
+    }
+    manifest << "# Generated by atlas_packer, do not edit\n";
+    manifest << "image " << imagePath.filename().string() << ' ' << width << ' ' << height
+             << '\n';
+    for (const auto& item : items)
+        manifest << "sprite " << item.name << ' ' << item.x << ' ' << item.y << ' ' << item.width
+                 << ' ' << item.height << '\n';
+
+    std::cout << "Packed " << items.size() << " sprites into " << width << "x" << height << " → "
+              << imagePath.string() << '\n';
+    return 0;
+}
@@ -0,0 +1,180 @@
+// Headless batch extraction of Fourier descriptors for a directory of kamon images.
+//
+//   kamon_batch <input_dir> <output.{csv,bin}> [--components N] [--threads N]
+//
+// Every *.png / *.jpg / *.svg below <input_dir> runs through the same pipeline as the
+// KamonFourier screen (ContourExtractor → shift/normalise → computeFourier).
+#include "../modules/kamon_fourier/components/contourExtractor/contourExtractor.h"
+#include "../modules/kamon_fourier/components/descriptorTable/descriptorTable.h"
+#include "../modules/kamon_fourier/components/fourierPipeline/fourierPipeline.h"
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace KamonFourier;
+
+namespace
+{
+struct Options
+{
+    fs::path inputDir;
+    fs::path outputFile;
+    int      numComponents = 48;
+    unsigned numThreads    = std::max(1u, std::thread::hardware_concurrency());
+};
+
+void printUsage()
+{
+    std::cerr << "Usage: kamon_batch <input_dir> <output.{csv,bin}> [--components N] "
+                 "[--threads N]\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opts)
+{
+    std::vector<std::string> positional;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--components" && i + 1 < argc)
+                opts.numComponents = std::stoi(argv[++i]);
+            else if (arg == "--threads" && i + 1 < argc)
+                opts.numThreads = static_cast<unsigned>(std::max(1, std::stoi(argv[++i])));
+            else if (!arg.empty() && arg[0] == '-')
+                return false;
+            else
+                positional.push_back(arg);
+        }
+    }
+    catch (const std::exception&) // std::invalid_argument / std::out_of_range
+    {
+        return false;
+    }
+
+    if (positional.size() != 2 || opts.numComponents < 1)
+        return false;
+
+    opts.inputDir   = positional[0];
+    opts.outputFile = positional[1];
+    return true;
+}
+
+std::string lowerExtension(const fs::path& p)
+{
+    std::string ext = p.extension().string();
+    std::transform(
+        ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext;
+}
+
+bool isShapeFile(const fs::path& p)
+{
+    const std::string ext = lowerExtension(p);
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg"
+           || ContourExtractor::isSvgFile(p.string());
+}
+
+bool processShape(const fs::path& file, int numComponents, DescriptorTable::Record& rec)
+{
+    std::vector<sf::Vector2f> pts = ContourExtractor::extractShapeContour(file.string());
+    if (pts.empty())
+        return false;
+
+    rec.numPoints = static_cast<std::uint32_t>(pts.size());
+    return FourierPipeline::process(pts, numComponents, rec.fourier);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    if (!parseArgs(argc, argv, opts))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (!fs::is_directory(opts.inputDir))
+    {
+        std::cerr << "Input directory not found: " << opts.inputDir << '\n';
+        return 1;
+    }
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(opts.inputDir))
+    {
+        if (entry.is_regular_file() && isShapeFile(entry.path()))
+            files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    if (files.empty())
+    {
+        std::cerr << "No PNG/JPG/SVG files found in " << opts.inputDir << '\n';
+        return 1;
+    }
+
+    // We parallelise across files, so keep OpenCV from spawning its own pool per call
+    cv::setNumThreads(1);
+
+    std::vector<DescriptorTable::Record> records(files.size());
+    std::vector<char>                    ok(files.size(), 0);
+    std::atomic<std::size_t>             next{0};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]()
+    {
+        for (std::size_t i = next++; i < files.size(); i = next++)
+        {
+            records[i].name = fs::relative(files[i], opts.inputDir).generic_string();
+            ok[i]           = processShape(files[i], opts.numComponents, records[i]);
+        }
+    };
+
+    const auto threadCount =
+        static_cast<unsigned>(std::min<std::size_t>(opts.numThreads, files.size()));
+    std::vector<std::thread> pool;
+    pool.reserve(threadCount);
+    for (unsigned t = 0; t < threadCount; ++t)
+        pool.emplace_back(worker);
+    for (auto& th : pool)
+        th.join();
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Keep the output order stable (sorted by path) and drop failed shapes
+    std::vector<DescriptorTable::Record> done;
+    done.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        if (ok[i])
+            done.push_back(std::move(records[i]));
+    }
+
+    const bool binary  = opts.outputFile.extension() == ".bin";
+    const bool written = binary ? DescriptorTable::writeBinary(opts.outputFile.string(), done)
+                                : DescriptorTable::writeCSV(opts.outputFile.string(), done);
+    if (!written)
+        return 1;
+
+    std::cout << "Processed " << done.size() << '/' << files.size() << " shapes on "
+              << threadCount << " threads in " << seconds << " s ("
+              << (seconds > 0.0 ? done.size() / seconds : 0.0) << " shapes/s)\n"
+              << "Wrote " << opts.outputFile << '\n';
+
+    return done.size() == files.size() ? 0 : 2;
+}
@@ -0,0 +1,119 @@
+// Shape similarity index over Fourier descriptors.
+//
+//   kamon_index build <descriptors.bin> <index.ksi>
+//   kamon_index query <index.ksi> <image.{png,jpg,svg}> [--top K] [--components N]
+//
+// <descriptors.bin> is the binary table written by kamon_batch. Queries must use the same
+// --components value the table was built with.
+#include "../modules/kamon_fourier/components/contourExtractor/contourExtractor.h"
+#include "../modules/kamon_fourier/components/descriptorTable/descriptorTable.h"
+#include "../modules/kamon_fourier/components/fourierPipeline/fourierPipeline.h"
+#include "../modules/kamon_fourier/components/shapeIndex/shapeIndex.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace KamonFourier;
+
+namespace
+{
+void printUsage()
+{
+    std::cerr << "Usage:\n"
+                 "  kamon_index build <descriptors.bin> <index.ksi>\n"
+                 "  kamon_index query <index.ksi> <image> [--top K] [--components N]\n";
+}
+
+int buildIndex(const std::string& tablePath, const std::string& indexPath)
+{
+    std::vector<DescriptorTable::Record> records;
+    if (!DescriptorTable::readBinary(tablePath, records))
+        return 1;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    ShapeIndex index;
+    for (const auto& rec : records)
+        index.add(rec.name, makeDescriptor(rec.fourier));
+    index.build();
+
+    const double ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+
+    if (!index.save(indexPath))
+        return 1;
+
+    std::cout << "Indexed " << index.size() << " shapes in " << ms << " ms → " << indexPath
+              << '\n';
+    return 0;
+}
+
+int queryIndex(const std::string& indexPath, const fs::path& image, std::size_t top, int components)
+{
+    ShapeIndex index;
+    if (!index.load(indexPath))
+        return 1;
+
+    std::vector<sf::Vector2f>    pts = ContourExtractor::extractShapeContour(image.string());
+    FourierPipeline::FourierData fourier;
+    if (pts.empty() || !FourierPipeline::process(pts, components, fourier))
+        return 1;
+
+    const Descriptor desc  = makeDescriptor(fourier);
+    const auto       start = std::chrono::steady_clock::now();
+    const auto       hits  = index.query(desc, top);
+    const double     us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+            .count();
+
+    for (std::size_t i = 0; i < hits.size(); ++i)
+        std::cout << i + 1 << ". " << hits[i].name << "  (d = " << hits[i].distance << ")\n";
+    std::cout << "Query over " << index.size() << " shapes took " << us << " µs\n";
+    return 0;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        printUsage();
+        return 1;
+    }
+
+    const std::string mode = argv[1];
+    if (mode == "build")
+        return buildIndex(argv[2], argv[3]);
+
+    if (mode == "query")
+    {
+        std::size_t top        = 5;
+        int         components = 48;
+        try
+        {
+            for (int i = 4; i + 1 < argc; i += 2)
+            {
+                const std::string arg = argv[i];
+                if (arg == "--top")
+                    top = static_cast<std::size_t>(std::stoul(argv[i + 1]));
+                else if (arg == "--components")
+                    components = std::stoi(argv[i + 1]);
+            }
+        }
+        catch (const std::exception&) // std::invalid_argument / std::out_of_range
+        {
+            printUsage();
+            return 1;
+        }
+        return queryIndex(argv[2], argv[3], top, components);
+    }
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,317 @@
+// Benchmark for TorchScript PINN models evaluated through ModelProcessor.
+//
+//   pinn_bench <model.pt> [--batch 1024,4096,...] [--threads 1,4,...] [--interop 1,2,...]
+//              [--steps 40000,...] [--repeats N] [--json out.json]
+//
+// Sweeps every combination of batch size (steps per forward pass), intra-op threads, inter-op
+// threads and input size. Each combination runs in a freshly forked process: libtorch only lets
+// the inter-op pool be sized once per process, and a clean process gives honest load times and
+// peak RSS. Reports model load time, the first (warm-up) inference, steady-state per-batch latency
+// percentiles and throughput; --json writes the same numbers for tracking across libtorch
+// upgrades. POSIX only (fork / getrusage).
+#include "../modules/ai_inference/ModelProcessor.h"
+
+#include <torch/script.h>
+#include <torch/version.h>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Config
+{
+    int batch   = 0;
+    int threads = 0;
+    int interop = 0;
+    int steps   = 0;
+};
+
+// Sent from the forked child to the parent through a pipe, hence plain data only
+struct Measurement
+{
+    bool   ok         = false;
+    double loadMs     = 0.0;
+    double warmupMs   = 0.0; // first forward pass after loading
+    double p50Ms      = 0.0; // per batch, steady state
+    double p95Ms      = 0.0;
+    double p99Ms      = 0.0;
+    double pointsPerS = 0.0;
+    long   peakRssKiB = 0;
+    int    batches    = 0; // latency samples behind the percentiles
+};
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<int> parseList(const std::string& text)
+{
+    std::vector<int>  values;
+    std::stringstream ss(text);
+    for (std::string item; std::getline(ss, item, ',');)
+    {
+        if (!item.empty())
+            values.push_back(std::max(1, std::stoi(item)));
+    }
+    return values;
+}
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    const auto rank = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+long peakRssKiB()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+// Runs inside the child process
+Measurement measure(const std::string& modelPath, const Config& config, int repeats)
+{
+    Measurement result;
+    at::set_num_threads(config.threads);
+    at::set_num_interop_threads(config.interop);
+
+    ModelProcessor processor(modelPath, config.steps);
+    processor.setCacheDir(""); // always evaluate
+
+    auto start = Clock::now();
+    if (!processor.loadModel())
+        return result;
+    result.loadMs = msSince(start);
+
+    // Warm-up: the first batch pays for graph optimisation and allocator growth.
+    // The callback stops infer() right after it, so its result is always false.
+    start = Clock::now();
+    processor.infer(config.batch, [](int, int) { return false; });
+    result.warmupMs = msSince(start);
+
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<std::size_t>(repeats) * (config.steps / config.batch + 1));
+    long long points = 0;
+
+    const auto sweepStart = Clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto       last = Clock::now();
+        int        prev = 0;
+        const bool ok   = processor.infer(
+            config.batch,
+            [&](int done, int)
+            {
+                // Partial tail batches would skew the per-batch latency
+                if (done - prev == config.batch)
+                    latencies.push_back(msSince(last));
+                last = Clock::now();
+                prev = done;
+                return true;
+            });
+        if (!ok)
+            return result;
+        points += config.steps;
+    }
+    const double sweepS = msSince(sweepStart) / 1000.0;
+
+    std::sort(latencies.begin(), latencies.end());
+    result.ok         = true;
+    result.p50Ms      = percentile(latencies, 50);
+    result.p95Ms      = percentile(latencies, 95);
+    result.p99Ms      = percentile(latencies, 99);
+    result.pointsPerS = sweepS > 0.0 ? points / sweepS : 0.0;
+    result.peakRssKiB = peakRssKiB();
+    result.batches    = static_cast<int>(latencies.size());
+    return result;
+}
+
+// Fork, measure in the child, read the result back through a pipe
+Measurement measureIsolated(const std::string& modelPath, const Config& config, int repeats)
+{
+    Measurement result;
+    int         fds[2];
+    if (pipe(fds) != 0)
+        return result;
+
+    std::cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return result;
+    }
+
+    if (pid == 0)
+    {
+        close(fds[0]);
+        // ModelProcessor logs every pass; keep the table readable (errors still go to stderr)
+        std::freopen("/dev/null", "w", stdout);
+        const Measurement m    = measure(modelPath, config, repeats);
+        const bool        sent = write(fds[1], &m, sizeof(m)) == static_cast<ssize_t>(sizeof(m));
+        close(fds[1]);
+        _exit(sent ? 0 : 1);
+    }
+
+    close(fds[1]);
+    if (read(fds[0], &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result)))
+        result = {};
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        result.ok = false;
+    return result;
+}
+
+void writeJson(
+    const std::string&              path,
+    const std::string&              modelPath,
+    int                             repeats,
+    const std::vector<Config>&      configs,
+    const std::vector<Measurement>& results)
+{
+    std::ofstream out(path);
+    if (!out.is_open())
+    {
+        std::cerr << "pinn_bench: cannot write " << path << '\n';
+        return;
+    }
+
+    out << std::fixed << std::setprecision(4);
+    out << "{\n";
+    out << "  \"libtorch\": \"" << TORCH_VERSION << "\",\n";
+    out << "  \"model\": \"" << modelPath << "\",\n";
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"repeats\": " << repeats << ",\n";
+    out << "  \"results\": [\n";
+    for (std::size_t i = 0; i < configs.size(); ++i)
+    {
+        const Config&      c = configs[i];
+        const Measurement& m = results[i];
+        out << "    {\"batch\": " << c.batch << ", \"intra_op_threads\": " << c.threads
+            << ", \"inter_op_threads\": " << c.interop << ", \"steps\": " << c.steps
+            << ", \"ok\": " << (m.ok ? "true" : "false") << ", \"load_ms\": " << m.loadMs
+            << ", \"warmup_ms\": " << m.warmupMs << ", \"p50_ms\": " << m.p50Ms
+            << ", \"p95_ms\": " << m.p95Ms << ", \"p99_ms\": " << m.p99Ms
+            << ", \"points_per_s\": " << m.pointsPerS << ", \"peak_rss_kib\": " << m.peakRssKiB
+            << ", \"batches\": " << m.batches << "}" << (i + 1 < configs.size() ? "," : "")
+            << '\n';
+    }
+    out << "  ]\n}\n";
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: pinn_bench <model.pt> [--batch 1024,4096] [--threads 1,4] "
+                     "[--interop 1] [--steps 40000] [--repeats N] [--json out.json]\n";
+        return 1;
+    }
+
+    const int hw = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    const std::string modelPath = argv[1];
+    std::vector<int>  batches   = {1024, 4096, 16384};
+    std::vector<int>  threads   = {1, hw};
+    std::vector<int>  interop   = {1};
+    std::vector<int>  steps     = {40000};
+    int               repeats   = 10;
+    std::string       jsonPath;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--batch" && i + 1 < argc)
+            batches = parseList(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = parseList(argv[++i]);
+        else if (arg == "--interop" && i + 1 < argc)
+            interop = parseList(argv[++i]);
+        else if (arg == "--steps" && i + 1 < argc)
+            steps = parseList(argv[++i]);
+        else if (arg == "--repeats" && i + 1 < argc)
+            repeats = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else
+        {
+            std::cerr << "pinn_bench: unknown argument " << arg << '\n';
+            return 1;
+        }
+    }
+    threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+
+    std::vector<Config> configs;
+    for (const int s : steps)
+        for (const int b : batches)
+            for (const int t : threads)
+                for (const int io : interop)
+                    configs.push_back({std::min(b, s), t, io, s});
+
+    std::cout << "libtorch " << TORCH_VERSION << ", " << hw << " hardware threads, " << repeats
+              << " repeats per configuration\n\n";
+    std::cout << std::left << std::setw(10) << "steps" << std::setw(8) << "batch" << std::setw(9)
+              << "threads" << std::setw(9) << "interop" << std::setw(10) << "load ms"
+              << std::setw(11) << "warmup ms" << std::setw(10) << "p50 ms" << std::setw(10)
+              << "p95 ms" << std::setw(10) << "p99 ms" << std::setw(14) << "points/s"
+              << "peak RSS MiB\n";
+
+    std::vector<Measurement> results;
+    results.reserve(configs.size());
+    for (const auto& c : configs)
+    {
+        const Measurement m = measureIsolated(modelPath, c, repeats);
+        results.push_back(m);
+
+        std::cout << std::left << std::setw(10) << c.steps << std::setw(8) << c.batch
+                  << std::setw(9) << c.threads << std::setw(9) << c.interop;
+        if (!m.ok)
+        {
+            std::cout << "failed\n";
+            continue;
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << m.loadMs
+                  << std::setw(11) << m.warmupMs << std::setw(10) << m.p50Ms << std::setw(10)
+                  << m.p95Ms << std::setw(10) << m.p99Ms << std::setw(14) << std::setprecision(0)
+                  << m.pointsPerS << std::setprecision(1) << m.peakRssKiB / 1024.0 << '\n'
+                  << std::defaultfloat;
+    }
+
+    if (!jsonPath.empty())
+    {
+        writeJson(jsonPath, modelPath, repeats, configs, results);
+        std::cout << "\nWrote " << jsonPath << '\n';
+    }
+
+    const bool allOk =
+        std::all_of(results.begin(), results.end(), [](const Measurement& m) { return m.ok; });
+    return allOk ? 0 : 1;
+}
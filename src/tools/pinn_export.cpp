@@ -0,0 +1,174 @@
+// Converts a TorchScript PINN into a native model file for the libtorch-free backend.
+//
+//   pinn_export <model.pt> <model.mlp> [--steps N] [--tolerance T]
+//
+// Reads the dense layers (ModelOptimizer::denseLayers) and the activation after each of them
+// (ModelOptimizer::layerActivations), writes them with NativeMlp::save and then checks the
+// result: the standard grid is evaluated with both backends through ModelProcessor, and the
+// maximum absolute error relative to the output range must stay within --tolerance (default
+// 1e-4). Prints load time, inference time and weight memory of both. Exit status is non-zero if
+// the model is not a plain MLP or the check fails; the written file is kept either way for
+// inspection.
+#include "../modules/ai_inference/ModelOptimizer.h"
+#include "../modules/ai_inference/ModelProcessor.h"
+#include "../modules/ai_inference/NativeMlp.h"
+
+#include <torch/script.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::unique_ptr<NativeMlp> convert(const std::string& modelPath)
+{
+    try
+    {
+        torch::jit::Module module = torch::jit::load(modelPath);
+        module.eval();
+
+        const std::vector<ModelOptimizer::DenseLayer> dense = ModelOptimizer::denseLayers(module);
+        if (dense.empty())
+            return nullptr;
+
+        std::vector<NativeMlp::Activation> activations;
+        if (!ModelOptimizer::layerActivations(module, dense.size(), activations))
+            return nullptr;
+
+        std::vector<NativeMlp::Layer> layers;
+        for (std::size_t i = 0; i < dense.size(); ++i)
+        {
+            const at::Tensor& w = dense[i].weight;
+            const at::Tensor& b = dense[i].bias;
+
+            NativeMlp::Layer layer;
+            layer.inputs     = static_cast<int>(w.size(0));
+            layer.outputs    = static_cast<int>(w.size(1));
+            layer.activation = activations[i];
+            layer.weight.assign(w.data_ptr<float>(), w.data_ptr<float>() + w.numel());
+            layer.bias.assign(b.data_ptr<float>(), b.data_ptr<float>() + b.numel());
+            layers.push_back(std::move(layer));
+        }
+        return NativeMlp::fromLayers(std::move(layers));
+    }
+    catch (const c10::Error& e)
+    {
+        std::cerr << "pinn_export: " << e.what() << '\n';
+        return nullptr;
+    }
+}
+
+struct Run
+{
+    bool        ok          = false;
+    double      loadMs      = 0.0;
+    double      inferMs     = 0.0;
+    std::size_t weightBytes = 0;
+    std::string backend;
+};
+
+Run evaluate(ModelProcessor& processor)
+{
+    Run run;
+    processor.setCacheDir(""); // always evaluate
+
+    auto start = Clock::now();
+    if (!processor.loadModel())
+        return run;
+    run.loadMs = msSince(start);
+
+    start = Clock::now();
+    if (!processor.infer())
+        return run;
+    run.inferMs     = msSince(start);
+    run.weightBytes = processor.weightBytes();
+    run.backend     = processor.backendName();
+    run.ok          = true;
+    return run;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: pinn_export <model.pt> <model.mlp> [--steps N] [--tolerance T]\n";
+        return 1;
+    }
+
+    const std::string modelPath  = argv[1];
+    const std::string nativePath = argv[2];
+    int               steps      = 40000;
+    double            tolerance  = 1e-4; // max |error| / output range
+    for (int i = 3; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc)
+            steps = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--tolerance" && i + 1 < argc)
+            tolerance = std::stod(argv[++i]);
+        else
+        {
+            std::cerr << "pinn_export: unknown argument " << arg << '\n';
+            return 1;
+        }
+    }
+
+    const std::unique_ptr<NativeMlp> mlp = convert(modelPath);
+    if (!mlp || !mlp->save(nativePath))
+        return 1;
+    std::cout << "Wrote " << nativePath << ": " << mlp->layers().size() << " layers, "
+              << mlp->weightBytes() << " weight bytes\n\n";
+
+    ModelProcessor torchModel(modelPath, steps);
+    ModelProcessor nativeModel(nativePath, steps);
+    const Run      reference = evaluate(torchModel);
+    const Run      native    = evaluate(nativeModel);
+    if (!reference.ok || !native.ok)
+    {
+        std::cerr << "pinn_export: evaluation failed\n";
+        return 1;
+    }
+
+    const std::vector<float>& ref1 = torchModel.outputCol1();
+    const std::vector<float>& ref2 = torchModel.outputCol2();
+    const std::vector<float>& out1 = nativeModel.outputCol1();
+    const std::vector<float>& out2 = nativeModel.outputCol2();
+    double                    maxErr = 0.0;
+    for (std::size_t i = 0; i < ref1.size(); ++i)
+    {
+        maxErr = std::max<double>(maxErr, std::fabs(out1[i] - ref1[i]));
+        maxErr = std::max<double>(maxErr, std::fabs(out2[i] - ref2[i]));
+    }
+    const double range =
+        std::max(1e-12, static_cast<double>(torchModel.yMax()) - torchModel.yMin());
+    const double relErr = maxErr / range;
+    const bool   passed = relErr <= tolerance;
+
+    std::cout << std::left << std::setw(10) << "backend" << std::setw(11) << "load ms"
+              << std::setw(11) << "infer ms" << "weights KiB\n";
+    for (const Run* run : {&reference, &native})
+    {
+        std::cout << std::left << std::setw(10) << run->backend << std::fixed
+                  << std::setprecision(2) << std::setw(11) << run->loadMs << std::setw(11)
+                  << run->inferMs << run->weightBytes / 1024.0 << '\n'
+                  << std::defaultfloat;
+    }
+    std::cout << "\n" << steps << " grid steps: max |err| " << std::scientific
+              << std::setprecision(2) << maxErr << ", " << relErr << " of the output range ("
+              << (passed ? "ok" : "FAIL") << ", tolerance " << tolerance << ")\n"
+              << std::defaultfloat;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+// Accuracy / speed / memory report for the optimised variants of a TorchScript PINN.
+//
+//   pinn_optimize <model.pt> [--steps N] [--chunk N] [--repeats N] [--tolerance T]
+//
+// Evaluates the standard grid with every ModelProcessor::Optimization (as loaded, frozen +
+// optimize_for_inference, dynamic int8) and compares each against the unoptimised model:
+// maximum absolute error, the same relative to the output range, median inference time and
+// weight memory. A variant passes when its relative error stays within --tolerance; the exit
+// status is non-zero if any variant fails, so the check can gate a per-device choice in scripts.
+#include "../modules/ai_inference/ModelProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using Clock        = std::chrono::steady_clock;
+using Optimization = ModelProcessor::Optimization;
+
+struct Variant
+{
+    const char*  name;
+    Optimization optimization;
+};
+
+constexpr Variant kVariants[] = {
+    {"baseline", Optimization::None},
+    {"frozen", Optimization::Frozen},
+    {"int8", Optimization::DynamicInt8},
+};
+
+struct Report
+{
+    bool               ok          = false;
+    double             loadMs      = 0.0; // load + optimisation
+    double             medianMs    = 0.0;
+    std::size_t        weightBytes = 0;
+    std::vector<float> col1;
+    std::vector<float> col2;
+};
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+Report evaluate(
+    const std::string& modelPath,
+    Optimization       optimization,
+    int                steps,
+    int                chunk,
+    int                repeats)
+{
+    Report         report;
+    ModelProcessor processor(modelPath, steps);
+    processor.setCacheDir(""); // always evaluate
+    processor.setOptimization(optimization);
+
+    const auto start = Clock::now();
+    if (!processor.loadModel())
+        return report;
+    report.loadMs      = msSince(start);
+    report.weightBytes = processor.weightBytes();
+
+    // The first pass is warm-up (frozen graphs are specialised on it) and not timed
+    if (!processor.infer(chunk))
+        return report;
+
+    std::vector<double> times;
+    for (int r = 0; r < repeats; ++r)
+    {
+        const auto runStart = Clock::now();
+        if (!processor.infer(chunk))
+            return report;
+        times.push_back(msSince(runStart));
+    }
+    std::sort(times.begin(), times.end());
+
+    report.ok       = true;
+    report.medianMs = times[times.size() / 2];
+    report.col1     = processor.outputCol1();
+    report.col2     = processor.outputCol2();
+    return report;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: pinn_optimize <model.pt> [--steps N] [--chunk N] [--repeats N] "
+                     "[--tolerance T]\n";
+        return 1;
+    }
+
+    const std::string modelPath = argv[1];
+    int               steps     = 40000;
+    int               chunk     = 0; // one forward pass, as ModelProcessor::run() does
+    int               repeats   = 10;
+    double            tolerance = 0.01; // max |error| / output range
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc)
+            steps = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--chunk" && i + 1 < argc)
+            chunk = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--repeats" && i + 1 < argc)
+            repeats = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--tolerance" && i + 1 < argc)
+            tolerance = std::stod(argv[++i]);
+        else
+        {
+            std::cerr << "pinn_optimize: unknown argument " << arg << '\n';
+            return 1;
+        }
+    }
+
+    std::vector<Report> reports;
+    for (const auto& v : kVariants)
+        reports.push_back(evaluate(modelPath, v.optimization, steps, chunk, repeats));
+
+    const Report& baseline = reports.front();
+    if (!baseline.ok)
+    {
+        std::cerr << "pinn_optimize: the baseline model could not be evaluated\n";
+        return 1;
+    }
+
+    float lo = baseline.col1.front(), hi = lo;
+    for (const auto* col : {&baseline.col1, &baseline.col2})
+    {
+        const auto [mn, mx] = std::minmax_element(col->begin(), col->end());
+        lo                  = std::min(lo, *mn);
+        hi                  = std::max(hi, *mx);
+    }
+    const double range = std::max(1e-12, static_cast<double>(hi) - lo);
+
+    std::cout << steps << " grid steps, " << repeats << " timed runs per variant\n\n";
+    std::cout << std::left << std::setw(10) << "variant" << std::setw(11) << "load ms"
+              << std::setw(11) << "infer ms" << std::setw(9) << "speedup" << std::setw(12)
+              << "weights KiB" << std::setw(9) << "memory" << std::setw(12) << "max |err|"
+              << std::setw(12) << "rel err" << "check\n";
+
+    bool allPassed = true;
+    for (std::size_t v = 0; v < reports.size(); ++v)
+    {
+        const Report& r = reports[v];
+        std::cout << std::left << std::setw(10) << kVariants[v].name;
+        if (!r.ok)
+        {
+            std::cout << "failed\n";
+            allPassed = false;
+            continue;
+        }
+
+        double maxErr = 0.0;
+        for (std::size_t i = 0; i < r.col1.size(); ++i)
+        {
+            maxErr = std::max<double>(maxErr, std::fabs(r.col1[i] - baseline.col1[i]));
+            maxErr = std::max<double>(maxErr, std::fabs(r.col2[i] - baseline.col2[i]));
+        }
+        const double memory =
+            static_cast<double>(r.weightBytes) / std::max<std::size_t>(baseline.weightBytes, 1);
+        const double relErr = maxErr / range;
+        const bool   passed = relErr <= tolerance;
+        allPassed           = allPassed && passed;
+
+        std::cout << std::fixed << std::setprecision(2) << std::setw(11) << r.loadMs
+                  << std::setw(11) << r.medianMs << std::setw(9)
+                  << baseline.medianMs / std::max(r.medianMs, 1e-9) << std::setw(12)
+                  << r.weightBytes / 1024.0 << std::setw(9) << memory << std::scientific
+                  << std::setprecision(2) << std::setw(12) << maxErr << std::setw(12) << relErr
+                  << (passed ? "ok" : "FAIL") << '\n'
+                  << std::defaultfloat;
+    }
+
+    std::cout << "\nmemory = weight bytes relative to the baseline; tolerance " << tolerance
+              << " of the output range\n";
+    return allPassed ? 0 : 1;
+}
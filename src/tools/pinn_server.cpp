@@ -0,0 +1,441 @@
+// Local inference daemon: loads models once and serves them over a Unix socket. Models are
+// TorchScript files or native exports (pinn_export), see InferenceBackend.
+//
+//   pinn_server serve <socket> <name>=<model.pt>... [--max-batch N] [--max-wait-us U]
+//                     [--threads T]
+//   pinn_server query <socket> <name> <x>...
+//
+// Every model gets its own batching thread. Requests that arrive while it waits (at most
+// --max-wait-us after the first one) are coalesced into a single forward pass of up to
+// --max-batch points, so many small requests from different tools cost about as much as one
+// large one. Wire format and the client helper: ai_inference/InferenceProtocol.h. POSIX only.
+#include "../modules/ai_inference/InferenceProtocol.h"
+#include "../modules/ai_inference/ModelProcessor.h"
+
+#include <torch/script.h>
+
+#include <poll.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using InferenceProtocol::Status;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+std::atomic<bool> g_stop{false};
+
+void onSignal(int)
+{
+    g_stop = true;
+}
+
+struct Reply
+{
+    Status             status = Status::Failed;
+    std::vector<float> col1;
+    std::vector<float> col2;
+};
+
+// Queue + worker thread for one loaded model; forms the dynamic batches
+class ModelBatcher
+{
+  public:
+    ModelBatcher(std::unique_ptr<ModelProcessor> model, int maxBatch, Clock::duration maxWait)
+        : m_model(std::move(model))
+        , m_maxBatch(maxBatch)
+        , m_maxWait(maxWait)
+        , m_worker([this] { loop(); })
+    {
+    }
+
+    ~ModelBatcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_cv.notify_all();
+        m_worker.join();
+    }
+
+    ModelBatcher(const ModelBatcher&)            = delete;
+    ModelBatcher& operator=(const ModelBatcher&) = delete;
+
+    std::future<Reply> submit(std::vector<float> inputs)
+    {
+        Pending pending{std::move(inputs), {}};
+        auto    future = pending.reply.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queuedPoints += pending.inputs.size();
+            m_queue.push_back(std::move(pending));
+        }
+        m_cv.notify_all();
+        return future;
+    }
+
+    // Requests served and forward batches run so far (worker thread only writes them)
+    std::size_t requests() const
+    {
+        return m_requests;
+    }
+    std::size_t batches() const
+    {
+        return m_batches;
+    }
+
+  private:
+    struct Pending
+    {
+        std::vector<float>  inputs;
+        std::promise<Reply> reply;
+    };
+
+    void loop()
+    {
+        for (;;)
+        {
+            std::vector<Pending> batch;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty())
+                    return; // stopping and drained
+
+                // Give concurrent requests up to m_maxWait to join the first one
+                const auto deadline = Clock::now() + m_maxWait;
+                const auto full     = [this]
+                {
+                    return m_stopping
+                           || m_queuedPoints >= static_cast<std::size_t>(m_maxBatch);
+                };
+                m_cv.wait_until(lock, deadline, full);
+
+                // Always take the first request, even when it alone exceeds the batch size
+                std::size_t points = 0;
+                while (!m_queue.empty()
+                       && (batch.empty()
+                           || points + m_queue.front().inputs.size()
+                                  <= static_cast<std::size_t>(m_maxBatch)))
+                {
+                    points += m_queue.front().inputs.size();
+                    batch.push_back(std::move(m_queue.front()));
+                    m_queue.pop_front();
+                }
+                m_queuedPoints -= points;
+            }
+            runBatch(batch);
+        }
+    }
+
+    void runBatch(std::vector<Pending>& batch)
+    {
+        m_input.clear();
+        for (const auto& p : batch)
+            m_input.insert(m_input.end(), p.inputs.begin(), p.inputs.end());
+        m_col1.resize(m_input.size());
+        m_col2.resize(m_input.size());
+
+        // Oversized single requests are split into forward passes of at most m_maxBatch
+        bool ok = true;
+        for (std::size_t offset = 0; ok && offset < m_input.size(); offset += m_maxBatch)
+        {
+            const int count =
+                static_cast<int>(std::min<std::size_t>(m_maxBatch, m_input.size() - offset));
+            ok = m_model->evaluate(
+                m_input.data() + offset, count, m_col1.data() + offset, m_col2.data() + offset);
+            ++m_batches;
+        }
+
+        std::size_t offset = 0;
+        for (auto& p : batch)
+        {
+            Reply reply;
+            reply.status = ok ? Status::Ok : Status::Failed;
+            if (ok)
+            {
+                const auto first = static_cast<std::ptrdiff_t>(offset);
+                const auto last  = static_cast<std::ptrdiff_t>(offset + p.inputs.size());
+                reply.col1.assign(m_col1.begin() + first, m_col1.begin() + last);
+                reply.col2.assign(m_col2.begin() + first, m_col2.begin() + last);
+            }
+            offset += p.inputs.size();
+            p.reply.set_value(std::move(reply));
+        }
+        m_requests += batch.size();
+    }
+
+    std::unique_ptr<ModelProcessor> m_model;
+    int                             m_maxBatch;
+    Clock::duration                 m_maxWait;
+
+    // Batch buffers, reused (worker thread only)
+    std::vector<float>       m_input;
+    std::vector<float>       m_col1;
+    std::vector<float>       m_col2;
+    std::atomic<std::size_t> m_requests{0};
+    std::atomic<std::size_t> m_batches{0};
+
+    std::mutex              m_mutex; // guards the queue, m_queuedPoints and m_stopping
+    std::condition_variable m_cv;
+    std::deque<Pending>     m_queue;
+    std::size_t             m_queuedPoints = 0;
+    bool                    m_stopping     = false;
+    std::thread             m_worker; // last: starts after everything above is initialised
+};
+
+using Models = std::map<std::string, std::unique_ptr<ModelBatcher>>;
+
+bool sendReply(int fd, Status status, const Reply* reply = nullptr)
+{
+    InferenceProtocol::ResponseHeader header;
+    header.status = status;
+    header.count  = reply ? static_cast<std::uint32_t>(reply->col1.size()) : 0;
+    if (!InferenceProtocol::writeAll(fd, &header, sizeof(header)))
+        return false;
+    if (!reply)
+        return true;
+
+    const std::size_t bytes = reply->col1.size() * sizeof(float);
+    return InferenceProtocol::writeAll(fd, reply->col1.data(), bytes)
+           && InferenceProtocol::writeAll(fd, reply->col2.data(), bytes);
+}
+
+// One client connection: requests are answered in order until the client disconnects
+void serveConnection(int fd, Models& models)
+{
+    for (;;)
+    {
+        InferenceProtocol::RequestHeader header;
+        if (!InferenceProtocol::readAll(fd, &header, sizeof(header)))
+            return;
+        if (header.magic != InferenceProtocol::kRequestMagic
+            || header.name_size > InferenceProtocol::kMaxNameSize
+            || header.count > InferenceProtocol::kMaxCount)
+        {
+            sendReply(fd, Status::BadRequest); // the stream cannot be resynchronised
+            return;
+        }
+
+        std::string        name(header.name_size, '\0');
+        std::vector<float> inputs(header.count);
+        if (!InferenceProtocol::readAll(fd, name.data(), name.size())
+            || !InferenceProtocol::readAll(fd, inputs.data(), inputs.size() * sizeof(float)))
+            return;
+
+        const auto it = models.find(name);
+        if (it == models.end())
+        {
+            if (!sendReply(fd, Status::UnknownModel))
+                return;
+            continue;
+        }
+
+        const Reply reply = it->second->submit(std::move(inputs)).get();
+        if (!sendReply(fd, reply.status, reply.status == Status::Ok ? &reply : nullptr))
+            return;
+    }
+}
+
+struct Connection
+{
+    int               fd = -1;
+    std::atomic<bool> done{false};
+    std::thread       thread;
+};
+
+int serve(int argc, char** argv)
+{
+    const std::string socketPath = argv[2];
+    int               maxBatch   = 8192;
+    int               maxWaitUs  = 2000;
+    int               threads    = 0;
+
+    std::map<std::string, std::string> modelPaths; // name → TorchScript file
+    for (int i = 3; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--max-batch" && i + 1 < argc)
+            maxBatch = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--max-wait-us" && i + 1 < argc)
+            maxWaitUs = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = std::max(1, std::stoi(argv[++i]));
+        else if (const auto eq = arg.find('='); eq != std::string::npos && eq > 0)
+            modelPaths[arg.substr(0, eq)] = arg.substr(eq + 1);
+        else
+        {
+            std::cerr << "pinn_server: expected <name>=<model.pt>, got " << arg << '\n';
+            return 1;
+        }
+    }
+    if (modelPaths.empty())
+    {
+        std::cerr << "pinn_server: no models given\n";
+        return 1;
+    }
+    if (threads > 0)
+        at::set_num_threads(threads);
+
+    sockaddr_un addr;
+    if (!InferenceProtocol::fillAddress(socketPath, addr))
+    {
+        std::cerr << "pinn_server: socket path too long: " << socketPath << '\n';
+        return 1;
+    }
+
+    // Refuse to steal the socket of a live server; remove a stale one left by a crash
+    std::vector<float> probe1, probe2;
+    if (InferenceProtocol::evaluate(socketPath, "", {}, probe1, probe2) != Status::Failed)
+    {
+        std::cerr << "pinn_server: a server is already listening on " << socketPath << '\n';
+        return 1;
+    }
+    ::unlink(socketPath.c_str());
+
+    // Load every model once, up front
+    Models models;
+    for (const auto& [name, path] : modelPaths)
+    {
+        const auto start = Clock::now();
+        auto       model = std::make_unique<ModelProcessor>(path, 0);
+        if (!model->loadModel())
+            return 1;
+        std::cout << "[pinn_server] " << name << ": " << path << " loaded in "
+                  << std::chrono::duration<double, std::milli>(Clock::now() - start).count()
+                  << " ms\n";
+        models[name] = std::make_unique<ModelBatcher>(
+            std::move(model), maxBatch, std::chrono::microseconds(maxWaitUs));
+    }
+
+    const int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0
+        || ::bind(listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::listen(listenFd, 64) != 0)
+    {
+        std::cerr << "pinn_server: cannot listen on " << socketPath << '\n';
+        if (listenFd >= 0)
+            ::close(listenFd);
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cout << "[pinn_server] serving " << models.size() << " model(s) on " << socketPath
+              << " (max batch " << maxBatch << ", max wait " << maxWaitUs << " us)\n";
+
+    std::list<Connection> connections;
+    while (!g_stop)
+    {
+        // Poll so a signal is noticed even without new clients
+        pollfd pfd{listenFd, POLLIN, 0};
+        if (::poll(&pfd, 1, 250) > 0 && (pfd.revents & POLLIN))
+        {
+            const int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd >= 0)
+            {
+                auto& c  = connections.emplace_back();
+                c.fd     = fd;
+                c.thread = std::thread(
+                    [&c, &models]
+                    {
+                        serveConnection(c.fd, models);
+                        c.done = true;
+                    });
+            }
+        }
+
+        // Reap finished clients
+        for (auto it = connections.begin(); it != connections.end();)
+        {
+            if (!it->done)
+            {
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            ::close(it->fd);
+            it = connections.erase(it);
+        }
+    }
+
+    // Unblock idle clients, then let in-flight requests finish before the batchers go away
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    for (auto& c : connections)
+        ::shutdown(c.fd, SHUT_RDWR);
+    for (auto& c : connections)
+    {
+        c.thread.join();
+        ::close(c.fd);
+    }
+
+    for (const auto& [name, batcher] : models)
+    {
+        std::cout << "[pinn_server] " << name << ": " << batcher->requests() << " requests in "
+                  << batcher->batches() << " forward passes\n";
+    }
+    return 0;
+}
+
+int query(int argc, char** argv)
+{
+    std::vector<float> inputs;
+    for (int i = 4; i < argc; ++i)
+        inputs.push_back(std::stof(argv[i]));
+
+    std::vector<float> col1, col2;
+    const Status       status = InferenceProtocol::evaluate(argv[2], argv[3], inputs, col1, col2);
+    if (status != Status::Ok)
+    {
+        std::cerr << "pinn_server: request failed (status " << static_cast<int>(status) << ")\n";
+        return 1;
+    }
+
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+        std::cout << inputs[i] << "," << col1[i] << "," << col2[i] << "\n";
+    return 0;
+}
+
+void printUsage()
+{
+    std::cerr << "Usage:\n"
+                 "  pinn_server serve <socket> <name>=<model.pt>... [--max-batch N] "
+                 "[--max-wait-us U] [--threads T]\n"
+                 "  pinn_server query <socket> <name> <x>...\n";
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        printUsage();
+        return 1;
+    }
+
+    const std::string mode = argv[1];
+    if (mode == "serve")
+        return serve(argc, argv);
+    if (mode == "query")
+        return query(argc, argv);
+
+    printUsage();
+    return 1;
+}
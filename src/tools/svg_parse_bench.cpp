@@ -0,0 +1,118 @@
+// Benchmark for the KamonFourier SVG path parser.
+//
+//   svg_parse_bench <file.svg | dir>... [--iterations N]
+//
+// Parses every <path> of every SVG with a few flattening tolerances and reports parse
+// throughput and the resulting point counts (which feed the FFT length).
+#include "../modules/kamon_fourier/components/svgPath/svgPath.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace KamonFourier;
+
+namespace
+{
+struct SvgFile
+{
+    fs::path    path;
+    std::string content;
+};
+
+void collect(const fs::path& p, std::vector<SvgFile>& files)
+{
+    auto add = [&](const fs::path& file)
+    {
+        std::ifstream in(file, std::ios::binary);
+        files.push_back(
+            {file, {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()}});
+    };
+
+    if (fs::is_directory(p))
+    {
+        for (const auto& entry : fs::recursive_directory_iterator(p))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".svg")
+                add(entry.path());
+        }
+    }
+    else if (fs::is_regular_file(p))
+        add(p);
+}
+
+// Parse all paths of one document; returns the total number of points
+std::size_t parseDocument(const std::string& svg, float tolerance, SvgPath::Subpaths& out)
+{
+    out.clear();
+    std::size_t pos = 0;
+    for (auto d = SvgPath::nextPathData(svg, pos); !d.empty(); d = SvgPath::nextPathData(svg, pos))
+        SvgPath::parse(d, tolerance, out);
+    return out.points.size();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int                  iterations = 200;
+    std::vector<SvgFile> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc)
+            iterations = std::max(1, std::stoi(argv[++i]));
+        else
+            collect(arg, files);
+    }
+
+    if (files.empty())
+    {
+        std::cerr << "Usage: svg_parse_bench <file.svg | dir>... [--iterations N]\n";
+        return 1;
+    }
+
+    std::size_t totalBytes = 0;
+    for (const auto& f : files)
+        totalBytes += f.content.size();
+
+    std::cout << files.size() << " SVG files, " << totalBytes / 1024.0 << " KiB, " << iterations
+              << " iterations\n\n";
+    std::cout << std::left << std::setw(12) << "tolerance" << std::setw(14) << "points/file"
+              << std::setw(14) << "µs/file" << "MB/s\n";
+
+    SvgPath::Subpaths scratch; // reused across files, like the app does per document
+    for (const float tolerance : {1.0f, 0.25f, 0.05f})
+    {
+        std::size_t points = 0;
+        for (const auto& f : files)
+            points += parseDocument(f.content, tolerance, scratch);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it)
+        {
+            for (const auto& f : files)
+                parseDocument(f.content, tolerance, scratch);
+        }
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const double runs = static_cast<double>(iterations) * files.size();
+        std::cout << std::left << std::setw(12) << tolerance << std::setw(14)
+                  << points / static_cast<double>(files.size()) << std::setw(14)
+                  << seconds * 1e6 / runs << totalBytes * iterations / seconds / 1e6 << '\n';
+    }
+
+    std::cout << "\nPer file (tolerance 0.25):\n";
+    for (const auto& f : files)
+    {
+        parseDocument(f.content, 0.25f, scratch);
+        std::cout << "  " << f.path.filename().string() << ": " << scratch.count()
+                  << " subpaths, " << scratch.points.size() << " points\n";
+    }
+    return 0;
+}
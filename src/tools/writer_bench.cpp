@@ -0,0 +1,127 @@
+// Throughput of the result writers in src/io against plain `std::ofstream <<`.
+//
+//   writer_bench [--rows N] [--dir DIR]
+//
+// Writes N rows of two float columns (model-output-like values, default 10M) in each format and
+// reports wall time, MB/s and rows/s. Files go to DIR (default: the temp directory) and are
+// removed afterwards.
+#include "../io/array_writer.h"
+#include "../io/csv_writer.h"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+void report(
+    const char*                  name,
+    const fs::path&              path,
+    std::size_t                  rows,
+    const std::function<bool()>& write)
+{
+    const auto   start = std::chrono::steady_clock::now();
+    const bool   ok    = write();
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::error_code ec;
+    const auto      bytes = ok ? fs::file_size(path, ec) : 0;
+    fs::remove(path, ec);
+    if (!ok)
+    {
+        std::cout << std::left << std::setw(16) << name << "failed\n";
+        return;
+    }
+
+    std::cout << std::left << std::setw(16) << name << std::fixed << std::setprecision(3)
+              << std::setw(10) << seconds << std::setprecision(1) << std::setw(12)
+              << bytes / 1e6 << std::setw(10) << bytes / 1e6 / seconds << std::setprecision(2)
+              << rows / 1e6 / seconds << '\n'
+              << std::defaultfloat;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t rows = 10'000'000;
+    fs::path    dir  = fs::temp_directory_path();
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--rows" && i + 1 < argc)
+            rows = std::stoull(argv[++i]);
+        else if (arg == "--dir" && i + 1 < argc)
+            dir = argv[++i];
+        else
+        {
+            std::cerr << "Usage: writer_bench [--rows N] [--dir DIR]\n";
+            return 1;
+        }
+    }
+
+    std::vector<float> col1(rows), col2(rows);
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        const float x = static_cast<float>(i * 0.001);
+        col1[i]       = std::sin(x) * std::exp(-0.01f * x);
+        col2[i]       = std::cos(x) * 3.7f;
+    }
+
+    std::cout << rows << " rows x 2 float columns\n\n";
+    std::cout << std::left << std::setw(16) << "writer" << std::setw(10) << "seconds"
+              << std::setw(12) << "MB" << std::setw(10) << "MB/s" << "Mrows/s\n";
+
+    const fs::path csvPath = dir / "writer_bench.csv";
+    report(
+        "ofstream <<",
+        csvPath,
+        rows,
+        [&]
+        {
+            std::ofstream out(csvPath);
+            for (std::size_t i = 0; i < rows; ++i)
+                out << col1[i] << "," << col2[i] << "\n";
+            return static_cast<bool>(out);
+        });
+    report(
+        "CsvWriter",
+        csvPath,
+        rows,
+        [&]
+        {
+            CsvWriter csv;
+            if (!csv.open(csvPath.string()))
+                return false;
+            for (std::size_t i = 0; i < rows; ++i)
+                csv.row(col1[i], col2[i]);
+            return csv.close();
+        });
+
+    const fs::path npyPath = dir / "writer_bench.npy";
+    report(
+        ".npy",
+        npyPath,
+        rows,
+        [&] { return ArrayWriter::writeNpy(npyPath.string(), {col1.data(), col2.data()}, rows); });
+
+    const fs::path rawPath = dir / "writer_bench.f32";
+    report(
+        "raw float32",
+        rawPath,
+        rows,
+        [&]
+        {
+            return ArrayWriter::writeRawFloat32(
+                rawPath.string(), {col1.data(), col2.data()}, rows);
+        });
+    return 0;
+}